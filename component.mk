@@ -1,2 +1,25 @@
 COMPONENT_INCDIRS = src/include
 COMPONENT_SRCDIRS = src
+
+# Decode numbers as scaled decimal integers instead of double
+CONFIG_VARS += JSON_FIXED_POINT
+JSON_FIXED_POINT ?= 0
+GLOBAL_CFLAGS += -DJSON_FIXED_POINT=$(JSON_FIXED_POINT)
+
+# Use Eisel-Lemire algorithm to convert numbers to double, instead of strtod
+CONFIG_VARS += JSON_EISEL_LEMIRE
+ifneq (,$(filter Host Esp32,$(SMING_ARCH)))
+JSON_EISEL_LEMIRE ?= 1
+else
+JSON_EISEL_LEMIRE ?= 0
+endif
+GLOBAL_CFLAGS += -DJSON_EISEL_LEMIRE=$(JSON_EISEL_LEMIRE)
+
+# Size of stack buffer used when parsing from a Stream
+CONFIG_VARS += JSON_STREAM_CHUNK_SIZE
+ifeq ($(SMING_ARCH),Host)
+JSON_STREAM_CHUNK_SIZE ?= 4096
+else
+JSON_STREAM_CHUNK_SIZE ?= 64
+endif
+GLOBAL_CFLAGS += -DJSON_STREAM_CHUNK_SIZE=$(JSON_STREAM_CHUNK_SIZE)
@@ -0,0 +1,379 @@
+#include <SmingCore.h>
+#include <Corpus.h>
+#include <JSON/StreamingWriter.h>
+
+namespace Corpus
+{
+namespace
+{
+class Random
+{
+public:
+	uint32_t next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	unsigned range(unsigned count)
+	{
+		return next() % count;
+	}
+
+	uint64_t id()
+	{
+		return (uint64_t(next()) << 24) | next();
+	}
+
+	double real(double min, double max)
+	{
+		uint64_t bits = (uint64_t(next()) << 21) ^ next();
+		return min + (max - min) * double(bits & ((1ULL << 53) - 1)) / double(1ULL << 53);
+	}
+
+	template <size_t N> const char* pick(const char* const (&list)[N])
+	{
+		return list[range(N)];
+	}
+
+private:
+	uint32_t state{2463534242U};
+};
+
+using Writer = JSON::StaticStreamingWriter<512>;
+
+const char* const words[]{
+	"the",	 "stream", "parser", "device", "memory", "quickly", "JSON",	"sensor", "update", "release",
+	"café",	"naïve",  "日本語",   "データ",	"🙂",	  "über",	"señal",  "réseau", "#iot",	"@sming",
+};
+
+void writeText(Writer& writer, Random& rnd, unsigned wordCount)
+{
+	char text[512];
+	unsigned length{0};
+	for(unsigned i = 0; i < wordCount; ++i) {
+		auto word = rnd.pick(words);
+		auto wordLength = strlen(word);
+		if(length + wordLength + 2 >= sizeof(text)) {
+			break;
+		}
+		if(i != 0) {
+			// Occasional characters requiring escapes
+			auto r = rnd.range(40);
+			text[length++] = (r == 0) ? '\n' : (r == 1) ? '"' : ' ';
+		}
+		memcpy(&text[length], word, wordLength);
+		length += wordLength;
+	}
+	writer.value(text, length);
+}
+
+void writeIdString(Writer& writer, uint64_t id)
+{
+	char buf[24];
+	m_snprintf(buf, sizeof(buf), "%llu", (unsigned long long)id);
+	writer.value(buf);
+}
+
+/*
+ * Social media timeline: string-heavy objects with UTF-8 text, escapes and nested entities
+ */
+void generateTwitter(Print& output)
+{
+	const char* const names[]{"Sming", "ESP user", "データ分析", "Jörg", "maker_kid", "IoT Weekly"};
+	const char* const langs[]{"en", "ja", "de", "es", "fr"};
+
+	Writer writer(output);
+	Random rnd;
+	writer.beginObject();
+	writer.key("statuses");
+	writer.beginArray();
+	for(unsigned i = 0; i < 700; ++i) {
+		auto id = rnd.id();
+		writer.beginObject();
+		writer.key("created_at");
+		writer.value("Sun Aug 31 00:29:15 +0000 2014");
+		writer.key("id");
+		writer.value(id);
+		writer.key("id_str");
+		writeIdString(writer, id);
+		writer.key("text");
+		writeText(writer, rnd, 8 + rnd.range(20));
+		writer.key("source");
+		writer.value("<a href=\"http://twitter.com/download/iphone\" rel=\"nofollow\">Twitter for iPhone</a>");
+		writer.key("truncated");
+		writer.value(false);
+		writer.key("in_reply_to_status_id");
+		writer.nullValue();
+
+		writer.key("user");
+		writer.beginObject();
+		auto userId = rnd.id();
+		writer.key("id");
+		writer.value(userId);
+		writer.key("id_str");
+		writeIdString(writer, userId);
+		writer.key("name");
+		writer.value(rnd.pick(names));
+		writer.key("screen_name");
+		writer.value(rnd.pick(names));
+		writer.key("description");
+		writeText(writer, rnd, 4 + rnd.range(12));
+		writer.key("url");
+		writer.nullValue();
+		writer.key("followers_count");
+		writer.value(rnd.range(100000));
+		writer.key("friends_count");
+		writer.value(rnd.range(2000));
+		writer.key("verified");
+		writer.value(rnd.range(10) == 0);
+		writer.key("profile_image_url");
+		writer.value("http://pbs.twimg.com/profile_images/497760886795153410/LDjAwR_y_normal.jpeg");
+		writer.endObject();
+
+		writer.key("entities");
+		writer.beginObject();
+		writer.key("hashtags");
+		writer.beginArray();
+		for(unsigned n = rnd.range(3); n != 0; --n) {
+			writer.beginObject();
+			writer.key("text");
+			writer.value(rnd.pick(words));
+			writer.key("indices");
+			writer.beginArray();
+			auto start = rnd.range(100);
+			writer.value(start);
+			writer.value(start + 8);
+			writer.endArray();
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.key("urls");
+		writer.beginArray();
+		writer.endArray();
+		writer.endObject();
+
+		writer.key("retweet_count");
+		writer.value(rnd.range(500));
+		writer.key("favorite_count");
+		writer.value(rnd.range(500));
+		writer.key("lang");
+		writer.value(rnd.pick(langs));
+		writer.endObject();
+	}
+	writer.endArray();
+	writer.endObject();
+}
+
+/*
+ * Geographic outline: long arrays of high-precision coordinate pairs
+ */
+void generateCanada(Print& output)
+{
+	Writer writer(output);
+	Random rnd;
+	writer.beginObject();
+	writer.key("type");
+	writer.value("FeatureCollection");
+	writer.key("features");
+	writer.beginArray();
+	writer.beginObject();
+	writer.key("type");
+	writer.value("Feature");
+	writer.key("properties");
+	writer.beginObject();
+	writer.key("name");
+	writer.value("Canada");
+	writer.endObject();
+	writer.key("geometry");
+	writer.beginObject();
+	writer.key("type");
+	writer.value("Polygon");
+	writer.key("coordinates");
+	writer.beginArray();
+	for(unsigned ring = 0; ring < 240; ++ring) {
+		writer.beginArray();
+		for(unsigned i = 0; i < 240; ++i) {
+			writer.beginArray();
+			writer.value(rnd.real(-141.0, -52.0));
+			writer.value(rnd.real(41.0, 83.0));
+			writer.endArray();
+		}
+		writer.endArray();
+	}
+	writer.endArray();
+	writer.endObject();
+	writer.endObject();
+	writer.endArray();
+	writer.endObject();
+}
+
+/*
+ * Event catalogue: many small objects with integer identifiers, numeric keys and nulls
+ */
+void generateCitm(Print& output)
+{
+	const char* const areaNames[]{"Arrière-scène central", "1er balcon central", "2ème balcon bergerie cour",
+								  "Baignoire", "Corbeille", "Parterre"};
+	const char* const venues[]{"PLEYEL_PLEYEL", "OPERA_GARNIER", "SALLE_GAVEAU"};
+
+	Writer writer(output);
+	Random rnd;
+	char key[16];
+
+	writer.beginObject();
+	writer.key("areaNames");
+	writer.beginObject();
+	for(unsigned i = 0; i < 250; ++i) {
+		m_snprintf(key, sizeof(key), "%u", 205705993 + i);
+		writer.key(key);
+		writer.value(rnd.pick(areaNames));
+	}
+	writer.endObject();
+
+	writer.key("events");
+	writer.beginObject();
+	for(unsigned i = 0; i < 200; ++i) {
+		m_snprintf(key, sizeof(key), "%u", 138586341 + i * 4);
+		writer.key(key);
+		writer.beginObject();
+		writer.key("description");
+		writer.nullValue();
+		writer.key("id");
+		writer.value(138586341 + i * 4);
+		writer.key("logo");
+		writer.nullValue();
+		writer.key("name");
+		writer.value("30th Anniversary Tour");
+		writer.key("subTopicIds");
+		writer.beginArray();
+		for(unsigned n = 1 + rnd.range(4); n != 0; --n) {
+			writer.value(337184269 + rnd.range(100));
+		}
+		writer.endArray();
+		writer.key("subjectCode");
+		writer.nullValue();
+		writer.key("topicIds");
+		writer.beginArray();
+		writer.value(324846099);
+		writer.value(107888604);
+		writer.endArray();
+		writer.endObject();
+	}
+	writer.endObject();
+
+	writer.key("performances");
+	writer.beginArray();
+	for(unsigned i = 0; i < 3700; ++i) {
+		writer.beginObject();
+		writer.key("eventId");
+		writer.value(138586341 + rnd.range(200) * 4);
+		writer.key("id");
+		writer.value(339887544 + i);
+		writer.key("logo");
+		writer.nullValue();
+		writer.key("name");
+		writer.nullValue();
+		writer.key("prices");
+		writer.beginArray();
+		for(unsigned n = 1 + rnd.range(3); n != 0; --n) {
+			writer.beginObject();
+			writer.key("amount");
+			writer.value(9025 * (1 + rnd.range(20)));
+			writer.key("audienceSubCategoryId");
+			writer.value(337100890);
+			writer.key("seatCategoryId");
+			writer.value(338937295 + rnd.range(10));
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.key("seatCategories");
+		writer.beginArray();
+		writer.beginObject();
+		writer.key("areas");
+		writer.beginArray();
+		for(unsigned n = 1 + rnd.range(4); n != 0; --n) {
+			writer.beginObject();
+			writer.key("areaId");
+			writer.value(205705993 + rnd.range(250));
+			writer.key("blockIds");
+			writer.beginArray();
+			writer.endArray();
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.key("seatCategoryId");
+		writer.value(338937295);
+		writer.endObject();
+		writer.endArray();
+		writer.key("seatMapImage");
+		writer.nullValue();
+		writer.key("start");
+		writer.value(1372701600000LL + rnd.range(100000) * 1000LL);
+		writer.key("venueCode");
+		writer.value(rnd.pick(venues));
+		writer.endObject();
+	}
+	writer.endArray();
+	writer.endObject();
+}
+
+/*
+ * Log records, one document per line
+ */
+void generateNdjson(Print& output)
+{
+	const char* const levels[]{"debug", "info", "info", "info", "warn", "error"};
+	const char* const messages[]{"request completed", "cache miss", "retrying connection", "sensor reading",
+								 "configuration updated"};
+	const char* const tags[]{"edge", "api", "mqtt", "ota", "batch"};
+
+	Writer writer(output);
+	Random rnd;
+	char text[32];
+	for(unsigned i = 0; i < 20000; ++i) {
+		writer.beginObject();
+		writer.key("ts");
+		writer.value(1690000000000LL + i * 37);
+		writer.key("level");
+		writer.value(rnd.pick(levels));
+		writer.key("host");
+		m_snprintf(text, sizeof(text), "node-%u", rnd.range(64));
+		writer.value(text);
+		writer.key("msg");
+		writer.value(rnd.pick(messages));
+		writer.key("latency");
+		writer.value(rnd.real(0.1, 250.0));
+		writer.key("status");
+		writer.value(rnd.range(10) == 0 ? 500 : 200);
+		writer.key("path");
+		m_snprintf(text, sizeof(text), "/api/v1/items/%u", rnd.range(100000));
+		writer.value(text);
+		writer.key("tags");
+		writer.beginArray();
+		for(unsigned n = rnd.range(3); n != 0; --n) {
+			writer.value(rnd.pick(tags));
+		}
+		writer.endArray();
+		writer.endObject();
+		writer.flush();
+		writer.reset();
+		output.write('\n');
+	}
+}
+
+} // namespace
+
+const Generator generators[]{
+	{"twitter", generateTwitter, false},
+	{"canada", generateCanada, false},
+	{"citm_catalog", generateCitm, false},
+	{"ndjson", generateNdjson, true},
+};
+
+const unsigned generatorCount{ARRAY_SIZE(generators)};
+
+} // namespace Corpus
@@ -0,0 +1,402 @@
+#include <SmingCore.h>
+#include <JSON/StreamingParser.h>
+#include <JSON/StructuralParser.h>
+#include <JSON/StreamingWriter.h>
+#include <JSON/MappedFile.h>
+#include <JSON/KeyMap.h>
+#include <hostlib/CommandLine.h>
+#include <Corpus.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+/*
+ * Input is passed to `parse(const char*, unsigned)` in blocks of these sizes
+ */
+constexpr unsigned chunkSizes[]{16, 64, 512, 4096, 65536};
+
+/*
+ * Each measurement is repeated for at least this long
+ */
+unsigned minTime{200};
+
+struct Input {
+	String name;
+	const char* data;
+	size_t length;
+	bool multiDocument;
+	std::unique_ptr<MemoryDataStream> content;
+#if defined(ARCH_HOST) && !defined(__WIN32)
+	std::unique_ptr<JSON::MappedFile> file;
+#endif
+};
+
+std::vector<Input> inputs;
+
+/*
+ * Presents a block of memory as a Stream without direct access, so the parser must copy it
+ */
+class CorpusStream : public Stream
+{
+public:
+	CorpusStream(const char* data, size_t length) : data(data), length(length)
+	{
+	}
+
+	int available() override
+	{
+		return length - pos;
+	}
+
+	int read() override
+	{
+		return (pos < length) ? uint8_t(data[pos++]) : -1;
+	}
+
+	int peek() override
+	{
+		return (pos < length) ? uint8_t(data[pos]) : -1;
+	}
+
+	size_t readBytes(char* buffer, size_t count) override
+	{
+		count = std::min(count, length - pos);
+		memcpy(buffer, &data[pos], count);
+		pos += count;
+		return count;
+	}
+
+	void flush() override
+	{
+	}
+
+	size_t write(uint8_t) override
+	{
+		return 0;
+	}
+
+private:
+	const char* data;
+	size_t length;
+	size_t pos{0};
+};
+
+/*
+ * Measurements taken by every listener
+ */
+struct Metrics {
+	uint32_t elements;
+	uint16_t peakBuffer; ///< Parser buffer space occupied by key and value, as reported by the parser
+	uint16_t peakLevel;
+
+	void reset()
+	{
+		*this = Metrics{};
+	}
+
+	void update(const JSON::Element& element, bool segment = false)
+	{
+		if(!segment) {
+			++elements;
+		}
+		peakLevel = std::max(peakLevel, element.level);
+	}
+};
+
+/*
+ * Does nothing with elements, called by the parser without virtual dispatch
+ */
+class NullListener : public JSON::ListenerBase
+{
+public:
+	using ParserListener = NullListener;
+	static constexpr const char* name{"null"};
+
+	bool startElement(const JSON::Element& element)
+	{
+		metrics.update(element);
+		return true;
+	}
+
+	bool endElement(const JSON::Element&)
+	{
+		return true;
+	}
+
+	bool stringSegment(const JSON::Element& element, bool final)
+	{
+		metrics.update(element, !final);
+		return true;
+	}
+
+	Metrics metrics;
+};
+
+/*
+ * Typical application listener: matches keys and converts values, using virtual dispatch
+ */
+class StatsListener : public JSON::Listener
+{
+public:
+	using ParserListener = JSON::Listener;
+	static constexpr const char* name{"stats"};
+
+	bool startElement(const JSON::Element& element) override
+	{
+		metrics.update(element);
+		switch(element.type) {
+		case JSON::Element::Type::Number:
+			total += element.as<double>();
+			break;
+		case JSON::Element::Type::String:
+			stringBytes += element.valueLength;
+			break;
+		default:;
+		}
+		if(keys.find(element) >= 0) {
+			++matches;
+		}
+		return true;
+	}
+
+	bool endElement(const JSON::Element&) override
+	{
+		return true;
+	}
+
+	bool stringSegment(const JSON::Element& element, bool final) override
+	{
+		metrics.update(element, !final);
+		stringBytes += element.valueLength;
+		return true;
+	}
+
+	Metrics metrics;
+
+private:
+	static constexpr auto keys = JSON::makeKeyMap("id", "text", "name", "coordinates", "amount", "latency");
+	double total{0};
+	size_t stringBytes{0};
+	unsigned matches{0};
+};
+
+bool succeeded(const Input& input, JSON::Status status)
+{
+	if(status == JSON::Status::EndOfDocument) {
+		return true;
+	}
+	// Multi-document input ends without a final document
+	return input.multiDocument && (status == JSON::Status::Ok || status == JSON::Status::NoMoreData);
+}
+
+/*
+ * Write one result as a line of JSON
+ */
+void report(const Input& input, const char* parser, const char* method, unsigned chunk, uint16_t bufsize,
+			const char* listener, JSON::Status status, const Metrics& metrics, unsigned iterations, double best,
+			double mean)
+{
+	JSON::StaticStreamingWriter<256> writer(Serial);
+	writer.beginObject();
+	writer.key("corpus");
+	writer.value(input.name);
+	writer.key("bytes");
+	writer.value(input.length);
+	writer.key("parser");
+	writer.value(parser);
+	writer.key("method");
+	writer.value(method);
+	writer.key("chunk");
+	writer.value(chunk);
+	writer.key("buffer");
+	writer.value(bufsize);
+	writer.key("listener");
+	writer.value(listener);
+	writer.key("status");
+	writer.value(toString(status));
+	writer.key("elements");
+	writer.value(metrics.elements);
+	writer.key("iterations");
+	writer.value(iterations);
+	writer.key("mbps");
+	writer.value(double(input.length) / best / 1e6);
+	writer.key("meanMbps");
+	writer.value(double(input.length) / mean / 1e6);
+	writer.key("nsPerElement");
+	writer.value(metrics.elements ? best * 1e9 / metrics.elements : 0.0);
+	writer.key("peakBuffer");
+	writer.value(metrics.peakBuffer);
+	writer.key("peakDepth");
+	writer.value(metrics.peakLevel);
+	writer.endObject();
+	writer.flush();
+	Serial.println();
+}
+
+/*
+ * Repeat a parse for at least `minTime` milliseconds and report the best and mean times
+ *
+ * The parser is constructed outside the timed region.
+ */
+template <class ListenerT, typename Create, typename Parse>
+void measure(const Input& input, const char* parser, const char* method, unsigned chunk, uint16_t bufsize,
+			 Create create, Parse parse)
+{
+	using Clock = std::chrono::steady_clock;
+	ListenerT listener;
+	JSON::Status status;
+	unsigned iterations{0};
+	Clock::duration total{};
+	Clock::duration best{Clock::duration::max()};
+	do {
+		listener.metrics.reset();
+		auto instance = create(listener);
+		auto start = Clock::now();
+		status = parse(*instance);
+		auto elapsed = Clock::now() - start;
+		listener.metrics.peakBuffer = instance->getPeakBufferUsage();
+		total += elapsed;
+		best = std::min(best, elapsed);
+		++iterations;
+	} while(total < std::chrono::milliseconds(minTime) && succeeded(input, status));
+
+	using Seconds = std::chrono::duration<double>;
+	report(input, parser, method, chunk, bufsize, ListenerT::name, status, listener.metrics, iterations,
+		   Seconds(best).count(), Seconds(total).count() / iterations);
+}
+
+template <uint16_t BUFSIZE, class ListenerT> void runListener(const Input& input)
+{
+	using Parser = JSON::StaticStreamingParser<BUFSIZE, typename ListenerT::ParserListener>;
+
+	auto createParser = [&](ListenerT& listener) {
+		auto parser = std::make_unique<Parser>(&listener);
+		// Multi-document corpora are all NDJSON
+		parser->setMultiDocument(input.multiDocument, true);
+		return parser;
+	};
+
+	measure<ListenerT>(input, "streaming", "block", input.length, BUFSIZE, createParser,
+					   [&](Parser& parser) { return parser.parse(input.data, input.length); });
+
+	for(auto chunk : chunkSizes) {
+		if(chunk >= input.length) {
+			break;
+		}
+		measure<ListenerT>(input, "streaming", "chunked", chunk, BUFSIZE, createParser, [&](Parser& parser) {
+			JSON::Status status{JSON::Status::Ok};
+			for(size_t pos = 0; pos < input.length && status == JSON::Status::Ok; pos += chunk) {
+				status = parser.parse(&input.data[pos], std::min(size_t(chunk), input.length - pos));
+			}
+			return status;
+		});
+	}
+
+	measure<ListenerT>(input, "streaming", "stream", JSON_STREAM_CHUNK_SIZE, BUFSIZE, createParser,
+					   [&](Parser& parser) {
+						   CorpusStream stream(input.data, input.length);
+						   return parser.parse(stream);
+					   });
+
+	if(!input.multiDocument) {
+		using StructuralParser = JSON::StaticStructuralParser<BUFSIZE, typename ListenerT::ParserListener>;
+		measure<ListenerT>(
+			input, "structural", "block", input.length, BUFSIZE,
+			[](ListenerT& listener) { return std::make_unique<StructuralParser>(&listener); },
+			[&](StructuralParser& parser) { return parser.parse(input.data, input.length); });
+	}
+}
+
+template <uint16_t BUFSIZE> void runBuffer(const Input& input)
+{
+	runListener<BUFSIZE, NullListener>(input);
+	runListener<BUFSIZE, StatsListener>(input);
+}
+
+void run(const Input& input)
+{
+	runBuffer<64>(input);
+	runBuffer<256>(input);
+	runBuffer<1024>(input);
+	runBuffer<4096>(input);
+}
+
+void addGenerated(const Corpus::Generator& generator)
+{
+	Input input{};
+	input.name = generator.name;
+	input.content = std::make_unique<MemoryDataStream>();
+	generator.generate(*input.content);
+	input.data = input.content->getStreamPointer();
+	input.length = input.content->available();
+	input.multiDocument = generator.multiDocument;
+	inputs.push_back(std::move(input));
+}
+
+#if defined(ARCH_HOST) && !defined(__WIN32)
+void addFile(const String& filename)
+{
+	auto file = std::make_unique<JSON::MappedFile>(filename.c_str());
+	if(!*file) {
+		Serial << _F("Cannot open '") << filename << '\'' << endl;
+		return;
+	}
+	auto name = filename.substring(filename.lastIndexOf('/') + 1);
+	Input input{};
+	input.name = name;
+	input.data = file->data();
+	input.length = file->size();
+	input.multiDocument = name.endsWith(".ndjson") || name.endsWith(".jsonl");
+	input.file = std::move(file);
+	inputs.push_back(std::move(input));
+}
+#endif
+
+/*
+ * Parameters:
+ *
+ * 	corpus=<file>	Add a corpus from the host filesystem, such as twitter.json. May be repeated. Not available on Windows.
+ * 	synthetic=0		Skip the generated corpora
+ * 	time=<ms>		Minimum time for each measurement
+ */
+void parseParameters()
+{
+	bool synthetic{true};
+	for(auto& param : commandLine.getParameters()) {
+		auto name = param.getName();
+		auto value = param.getValue();
+		if(name == "corpus") {
+#if defined(ARCH_HOST) && !defined(__WIN32)
+			addFile(value);
+#else
+			Serial << _F("Corpus files are not supported on Windows") << endl;
+#endif
+		} else if(name == "synthetic") {
+			synthetic = value.toInt() != 0;
+		} else if(name == "time") {
+			minTime = value.toInt();
+		}
+	}
+
+	if(synthetic) {
+		for(unsigned i = 0; i < Corpus::generatorCount; ++i) {
+			addGenerated(Corpus::generators[i]);
+		}
+	}
+}
+
+} // namespace
+
+void init()
+{
+	Serial.begin(SERIAL_BAUD_RATE);
+
+	parseParameters();
+	for(auto& input : inputs) {
+		run(input);
+	}
+
+	System.restart();
+}
@@ -0,0 +1,8 @@
+ARDUINO_LIBRARIES = JsonStreamingParser
+DISABLE_NETWORK = 1
+HOST_NETWORK_OPTIONS = --nonet
+
+# Timing and memory-mapped corpus files require the host emulator
+ifneq ($(SMING_ARCH),Host)
+$(error Benchmark sample supports Host architecture only)
+endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Print.h>
+
+namespace Corpus
+{
+/**
+ * @brief Generates a synthetic document resembling a commonly used benchmark file
+ *
+ * Content is produced from a fixed seed so results are comparable between runs.
+ */
+struct Generator {
+	const char* name;
+	void (*generate)(Print& output);
+	bool multiDocument; ///< Output is newline-delimited JSON
+};
+
+extern const Generator generators[];
+extern const unsigned generatorCount;
+
+} // namespace Corpus
@@ -1,6 +1,7 @@
 #include <SmingCore.h>
 #include <JSON/StreamingParser.h>
 #include <JSON/BasicListener.h>
+#include <JSON/Printer.h>
 #include <FlashString/Stream.hpp>
 
 IMPORT_FSTR(testFile, PROJECT_DIR "/files/test.json")
@@ -14,6 +15,15 @@ bool readTest(Stream& input, Print& output)
 	return status == JSON::Status::EndOfDocument;
 }
 
+bool prettyPrintTest(Stream& input, Print& output)
+{
+	JSON::PrettyPrinter<64> printer(output);
+	JSON::StaticStreamingParser<128> parser(&printer);
+	auto status = parser.parse(input);
+	output.println();
+	return status == JSON::Status::EndOfDocument;
+}
+
 void init()
 {
 	Serial.begin(SERIAL_BAUD_RATE);
@@ -22,6 +32,9 @@ void init()
 	FSTR::Stream fs(testFile);
 	readTest(fs, Serial);
 
+	FSTR::Stream fs2(testFile);
+	prettyPrintTest(fs2, Serial);
+
 #ifdef ARCH_HOST
 	System.restart();
 #endif
@@ -0,0 +1,405 @@
+#include "include/JSON/ArrayReader.h"
+
+#ifdef ARCH_HOST
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace JSON
+{
+namespace
+{
+// Parser takes unsigned block lengths
+constexpr size_t maxBlockSize{1U << 30};
+
+} // namespace
+
+/**
+ * @brief Elements produced by parsing one slice
+ */
+struct ArrayReader::SliceLog {
+	struct Event {
+		enum class Kind : uint8_t {
+			Start,
+			End,
+			Segment,
+			FinalSegment,
+		};
+		static constexpr size_t noString{SIZE_MAX};
+
+		Kind kind;
+		size_t keyPos;	 ///< Position of copied key in strings, or noString
+		size_t valuePos; ///< Position of copied value in strings, or noString
+		Element element;
+	};
+
+	std::vector<Event> events;
+	std::vector<char> strings;
+	uint32_t elementCount{0}; ///< Number of top-level array elements
+	Status status{Status::Ok};
+	bool ready{false};
+};
+
+/**
+ * @brief Listener used by worker threads to record elements
+ */
+class ArrayReader::Recorder : public ListenerBase
+{
+public:
+	using Kind = SliceLog::Event::Kind;
+
+	Recorder(SliceLog& log) : log(log)
+	{
+	}
+
+	bool startElement(const Element& element)
+	{
+		add(Kind::Start, element);
+		return true;
+	}
+
+	bool endElement(const Element& element)
+	{
+		add(Kind::End, element);
+		return true;
+	}
+
+	bool stringSegment(const Element& element, bool final)
+	{
+		add(final ? Kind::FinalSegment : Kind::Segment, element);
+		return true;
+	}
+
+private:
+	size_t copy(const char* s, bool isView, uint16_t length)
+	{
+		if(s == nullptr || isView) {
+			return SliceLog::Event::noString;
+		}
+		// Include NUL terminator
+		auto pos = log.strings.size();
+		log.strings.insert(log.strings.end(), s, s + length + 1);
+		return pos;
+	}
+
+	void add(Kind kind, const Element& element)
+	{
+		if(element.level == 1 && (kind == Kind::Start || kind == Kind::FinalSegment)) {
+			++log.elementCount;
+		}
+		auto keyPos = copy(element.key, element.keyIsView, element.keyLength);
+		auto valuePos = copy(element.value, element.valueIsView, element.valueLength);
+		log.events.push_back({kind, keyPos, valuePos, element});
+	}
+
+	SliceLog& log;
+};
+
+/**
+ * @brief Tracks listener state across slices
+ */
+struct ArrayReader::ReplayState {
+	uint32_t indexBase{0}; ///< Number of top-level elements in preceding slices
+	uint16_t skipLevel{0};
+	bool skipping{false};
+	bool segmented{false};
+};
+
+/**
+ * @brief Locates commas between top-level array elements, one slice at a time
+ */
+class ArrayReader::Scanner
+{
+public:
+	Scanner(const char* data, size_t length, size_t sliceSize)
+		: data(data), end(data + length), sliceSize(std::max(sliceSize, size_t(1)))
+	{
+		p = Scan::skipWhitespace(data, end);
+		if(p != end && *p == '[') {
+			sliceStart = p - data;
+			++p;
+		} else {
+			// Not an array, so content becomes a single slice
+			p = end;
+		}
+	}
+
+	/**
+	 * @brief Find the next slice
+	 *
+	 * The last slice runs to the end of the input, so includes the closing bracket and anything following.
+	 * Any problem with the structure also ends the scan, leaving the parser to report it.
+	 */
+	Slice next()
+	{
+		auto sliceEnd = sliceStart + sliceSize;
+		while(p < end) {
+			if(inString || depth > 1) {
+				p = Scan::findSkipSpecial(p, end);
+				if(p == end) {
+					break;
+				}
+			}
+			char c = *p++;
+			if(inString) {
+				if(c == '\\') {
+					++p;
+				} else if(c == '"') {
+					inString = false;
+				}
+				continue;
+			}
+			switch(c) {
+			case '"':
+				inString = true;
+				break;
+			case '[':
+			case '{':
+				++depth;
+				break;
+			case ']':
+			case '}':
+				if(--depth == 0) {
+					p = end;
+				}
+				break;
+			case ',':
+				if(depth == 1 && size_t(p - data) > sliceEnd) {
+					size_t pos = p - 1 - data;
+					if(Scan::skipWhitespace(data + sliceStart + 1, data + pos) == data + pos) {
+						// Empty element
+						p = end;
+						break;
+					}
+					Slice slice{sliceStart, pos, false};
+					sliceStart = pos;
+					return slice;
+				}
+				break;
+			default:;
+			}
+		}
+
+		return Slice{sliceStart, size_t(end - data), true};
+	}
+
+private:
+	const char* data;
+	const char* end;
+	const char* p;
+	size_t sliceSize;
+	size_t sliceStart{0};
+	unsigned depth{1};
+	bool inString{false};
+};
+
+void ArrayReader::parseSlice(const char* data, const Slice& slice, SliceLog& log) const
+{
+	Recorder recorder(log);
+	std::unique_ptr<char[]> buffer(new char[bufferSize]);
+	BasicStreamingParser<Recorder, maxNesting, uint32_t> parser(buffer.get(), bufferSize, &recorder);
+	parser.setZeroCopy(zeroCopy);
+
+	// Opening bracket stands in for the separating comma
+	parser.setOffset(slice.start);
+	auto status = parser.parse("[", 1);
+	for(auto pos = slice.start + 1; status == Status::Ok && pos < slice.end;) {
+		auto blockSize = std::min(slice.end - pos, maxBlockSize);
+		status = parser.parse(data + pos, blockSize);
+		pos += blockSize;
+	}
+	if(status == Status::Ok) {
+		// Last slice contains the real closing bracket
+		status = slice.last ? Status::NoMoreData : parser.parse("]", 1);
+	}
+	log.status = status;
+}
+
+Status ArrayReader::replay(SliceLog& log, ReplayState& state, bool first, bool last)
+{
+	using Kind = SliceLog::Event::Kind;
+
+	for(auto& event : log.events) {
+		auto& element = event.element;
+		if(element.level == 0) {
+			// Only the first opening bracket and last closing bracket are real
+			if((event.kind == Kind::Start && !first) || (event.kind == Kind::End && !last)) {
+				continue;
+			}
+		}
+		if(state.skipping) {
+			if(event.kind == Kind::End && element.level == state.skipLevel) {
+				state.skipping = false;
+			}
+			continue;
+		}
+
+		element.param = param;
+		if(event.keyPos != SliceLog::Event::noString) {
+			element.key = &log.strings[event.keyPos];
+		}
+		if(event.valuePos != SliceLog::Event::noString) {
+			element.value = &log.strings[event.valuePos];
+		}
+		if(element.level == 1 && event.kind != Kind::End) {
+			element.container.index += state.indexBase;
+		}
+
+		switch(event.kind) {
+		case Kind::Start:
+			if(!listener.startElement(element)) {
+				return Status::Cancelled;
+			}
+			if(listener.checkSkip() && (element.type == Element::Type::Object || element.type == Element::Type::Array)) {
+				state.skipping = true;
+				state.skipLevel = element.level;
+			}
+			break;
+		case Kind::End:
+			if(!listener.endElement(element)) {
+				return Status::Cancelled;
+			}
+			break;
+		case Kind::Segment:
+			if(!listener.stringSegment(element, false)) {
+				return state.segmented ? Status::Cancelled : Status::BufferFull;
+			}
+			state.segmented = true;
+			break;
+		case Kind::FinalSegment:
+			state.segmented = false;
+			if(!listener.stringSegment(element, true)) {
+				return Status::Cancelled;
+			}
+			listener.checkSkip();
+			break;
+		}
+	}
+
+	state.indexBase += log.elementCount;
+	if(log.status == Status::EndOfDocument && !last) {
+		return Status::Ok;
+	}
+	return log.status;
+}
+
+Status ArrayReader::parseSerial(const char* data, size_t length)
+{
+	std::unique_ptr<char[]> buffer(new char[bufferSize]);
+	Parser parser(buffer.get(), bufferSize, &listener, param);
+	parser.setZeroCopy(zeroCopy);
+	for(size_t pos = 0; pos < length;) {
+		auto blockSize = std::min(length - pos, maxBlockSize);
+		auto status = parser.parse(data + pos, blockSize);
+		if(status != Status::Ok) {
+			return status;
+		}
+		pos += blockSize;
+	}
+	return Status::NoMoreData;
+}
+
+Status ArrayReader::parse(const char* data, size_t length)
+{
+	Scanner scanner(data, length, sliceSize);
+	auto first = scanner.next();
+	if(first.last) {
+		// Too small to divide, or not an array
+		return parseSerial(data, length);
+	}
+
+	// Slices are added by the scanning thread whilst workers parse those already found
+	std::vector<Slice> slices{first};
+	std::deque<SliceLog> logs(1); // References remain valid as items are added
+	auto count = (threadCount != 0) ? threadCount : std::max(std::thread::hardware_concurrency(), 1U);
+	// Limit number of slices held in memory awaiting replay
+	const unsigned window = count * 2;
+	std::atomic<unsigned> nextSlice{0};
+	unsigned replayed{0};
+	bool stop{false};
+	std::mutex mutex;
+	std::condition_variable sliceParsed;
+	std::condition_variable sliceAvailable; ///< Slice found or replayed
+
+	auto scan = [&]() {
+		for(;;) {
+			auto slice = scanner.next();
+			std::lock_guard<std::mutex> lock(mutex);
+			if(stop) {
+				break;
+			}
+			slices.push_back(slice);
+			logs.emplace_back();
+			sliceAvailable.notify_all();
+			if(slice.last) {
+				break;
+			}
+		}
+	};
+
+	auto worker = [&]() {
+		for(;;) {
+			auto i = nextSlice++;
+			Slice slice;
+			SliceLog* log;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				sliceAvailable.wait(lock, [&]() {
+					bool scanned = slices.back().last;
+					return stop || (i < slices.size() && i < replayed + window) || (scanned && i >= slices.size());
+				});
+				if(stop || i >= slices.size()) {
+					break;
+				}
+				slice = slices[i];
+				log = &logs[i];
+			}
+			parseSlice(data, slice, *log);
+			std::lock_guard<std::mutex> lock(mutex);
+			log->ready = true;
+			sliceParsed.notify_one();
+		}
+	};
+
+	std::thread scanThread(scan);
+	std::vector<std::thread> threads;
+	for(unsigned i = 0; i < count; ++i) {
+		threads.emplace_back(worker);
+	}
+
+	auto status = Status::Ok;
+	ReplayState state;
+	for(unsigned i = 0; status == Status::Ok; ++i) {
+		SliceLog* log;
+		bool last;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			sliceParsed.wait(lock, [&]() { return i < logs.size() && logs[i].ready; });
+			log = &logs[i];
+			last = slices[i].last;
+		}
+		status = replay(*log, state, i == 0, last);
+		*log = SliceLog{};
+		std::lock_guard<std::mutex> lock(mutex);
+		++replayed;
+		if(status != Status::Ok) {
+			stop = true;
+		}
+		sliceAvailable.notify_all();
+	}
+
+	scanThread.join();
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	return status;
+}
+
+} // namespace JSON
+
+#endif
@@ -0,0 +1,136 @@
+#include "include/JSON/Binding.h"
+#include <cstring>
+
+namespace JSON
+{
+void FieldAccess::setString(char* dst, size_t size, const Element& element, bool append)
+{
+	switch(element.type) {
+	case Element::Type::String:
+	case Element::Type::Number:
+		break;
+	case Element::Type::Null:
+		if(!append) {
+			dst[0] = '\0';
+		}
+		return;
+	default:
+		return;
+	}
+
+	size_t pos = append ? strnlen(dst, size - 1) : 0;
+	size_t length = std::min(size_t(element.valueLength), size - 1 - pos);
+	memcpy(&dst[pos], element.value, length);
+	dst[pos + length] = '\0';
+}
+
+void Binder::push(void* object, const BindingBase* binding, const Field* array)
+{
+	frames[depth++] = Frame{object, binding, array, 0};
+}
+
+const Field* Binder::resolve(const Element& element, unsigned& index, bool start)
+{
+	if(element.level != depth) {
+		return nullptr;
+	}
+	auto& frame = frames[depth - 1];
+	if(frame.array != nullptr) {
+		// Parser's item counter may saturate, so count items here
+		if(start) {
+			++frame.itemCount;
+		}
+		index = frame.itemCount - 1;
+		return frame.array;
+	}
+	index = 0;
+	return frame.binding->find(element);
+}
+
+bool Binder::startElement(const Element& element)
+{
+	bool isObject = (element.type == Element::Type::Object);
+	bool isContainer = isObject || (element.type == Element::Type::Array);
+
+	if(element.level == 0) {
+		depth = 0;
+		if(isObject) {
+			push(object, &binding, nullptr);
+		} else if(isContainer) {
+			skipElement();
+		}
+		return true;
+	}
+
+	unsigned index;
+	auto field = resolve(element, index, true);
+	if(field == nullptr) {
+		if(isContainer) {
+			skipElement();
+		}
+		return true;
+	}
+
+	auto& frame = frames[depth - 1];
+	bool isItem = (frame.array != nullptr);
+	auto kind = isItem ? (field->binding ? Field::Kind::Object : Field::Kind::Value) : field->kind;
+	bool accepted{false};
+	switch(kind) {
+	case Field::Kind::Value:
+		if(!isContainer) {
+			field->set(frame.object, index, element, false);
+		}
+		break;
+
+	case Field::Kind::Object:
+		if(isObject && depth < maxNesting) {
+			auto nested = field->get(frame.object, index);
+			if(nested != nullptr) {
+				push(nested, field->binding, nullptr);
+				accepted = true;
+			}
+		}
+		break;
+
+	case Field::Kind::Array:
+		if(element.type == Element::Type::Array && depth < maxNesting) {
+			field->clear(frame.object);
+			push(frame.object, nullptr, field);
+			accepted = true;
+		}
+		break;
+	}
+
+	if(isContainer && !accepted) {
+		skipElement();
+	}
+	return true;
+}
+
+bool Binder::endElement(const Element& element)
+{
+	if(element.level + 1 == depth) {
+		--depth;
+	}
+	return true;
+}
+
+bool Binder::stringSegment(const Element& element, bool final)
+{
+	bool append = segmented;
+	segmented = !final;
+
+	unsigned index;
+	auto field = (element.level == 0) ? nullptr : resolve(element, index, !append);
+	if(field == nullptr) {
+		return true;
+	}
+	auto& frame = frames[depth - 1];
+	bool isValue = (frame.array != nullptr) ? (field->binding == nullptr) : (field->kind == Field::Kind::Value);
+	if(isValue) {
+		field->set(frame.object, index, element, append);
+	}
+	return true;
+}
+
+} // namespace JSON
@@ -0,0 +1,315 @@
+#include "include/JSON/Dom.h"
+#include <algorithm>
+#include <cstring>
+
+namespace JSON
+{
+namespace
+{
+/*
+ * Each node is followed by a Number (for numbers only), the key and the value text, both NUL-terminated.
+ * Nodes are aligned to 8 bytes.
+ */
+struct Node {
+	uint32_t next;		///< Position of following sibling
+	uint32_t length;	///< Length of value text, or number of items for objects and arrays
+	uint16_t keyLength; ///< Length of key text
+	Element::Type type;
+	uint8_t reserved;
+};
+
+constexpr uint32_t nodeAlign{8};
+
+constexpr uint32_t align(uint32_t offset)
+{
+	return (offset + nodeAlign - 1) & ~(nodeAlign - 1);
+}
+
+constexpr uint32_t headerSize{align(sizeof(Node))};
+constexpr uint32_t numberSize{align(sizeof(Number))};
+
+inline Node& getNode(const char* base, uint32_t offset)
+{
+	return *reinterpret_cast<Node*>(const_cast<char*>(base) + offset);
+}
+
+inline uint32_t keyOffset(const Node& node)
+{
+	return headerSize + ((node.type == Element::Type::Number) ? numberSize : 0);
+}
+
+inline uint32_t valueOffset(const Node& node)
+{
+	return keyOffset(node) + node.keyLength + 1;
+}
+
+inline uint32_t firstItem(const Node& node)
+{
+	return align(valueOffset(node));
+}
+
+bool isContainer(Element::Type type)
+{
+	return type == Element::Type::Object || type == Element::Type::Array;
+}
+
+DomValue findKey(DomValue::Iterator it, DomValue::Iterator end, const char* key)
+{
+	auto length = strlen(key);
+	for(; it != end; ++it) {
+		if((*it).keyIs(key, length)) {
+			return *it;
+		}
+	}
+	return DomValue();
+}
+
+DomValue findIndex(DomValue::Iterator it, DomValue::Iterator end, unsigned index)
+{
+	for(; it != end; ++it, --index) {
+		if(index == 0) {
+			return *it;
+		}
+	}
+	return DomValue();
+}
+
+} // namespace
+
+/* DomValue */
+
+DomValue::Iterator& DomValue::Iterator::operator++()
+{
+	offset = getNode(base, offset).next;
+	--remaining;
+	return *this;
+}
+
+Element::Type DomValue::getType() const
+{
+	return base ? getNode(base, offset).type : Element::Type::Null;
+}
+
+const char* DomValue::getKey() const
+{
+	return base ? &base[offset + keyOffset(getNode(base, offset))] : nullptr;
+}
+
+uint16_t DomValue::getKeyLength() const
+{
+	return base ? getNode(base, offset).keyLength : 0;
+}
+
+bool DomValue::keyIs(const char* key, unsigned length) const
+{
+	return base && getKeyLength() == length && memcmp(getKey(), key, length) == 0;
+}
+
+const char* DomValue::getValue() const
+{
+	switch(getType()) {
+	case Element::Type::Number:
+	case Element::Type::String:
+		return &base[offset + valueOffset(getNode(base, offset))];
+	default:
+		return nullptr;
+	}
+}
+
+uint32_t DomValue::getValueLength() const
+{
+	return getValue() ? getNode(base, offset).length : 0;
+}
+
+uint32_t DomValue::size() const
+{
+	return isContainer() ? getNode(base, offset).length : 0;
+}
+
+DomValue::Iterator DomValue::begin() const
+{
+	if(!isContainer()) {
+		return end();
+	}
+	auto& node = getNode(base, offset);
+	return Iterator(base, offset + firstItem(node), node.length);
+}
+
+DomValue DomValue::operator[](const char* key) const
+{
+	if(getType() != Element::Type::Object) {
+		return DomValue();
+	}
+	return findKey(begin(), end(), key);
+}
+
+DomValue DomValue::operator[](unsigned index) const
+{
+	return findIndex(begin(), end(), index);
+}
+
+Element DomValue::getElement() const
+{
+	Element element;
+	if(!base) {
+		return element;
+	}
+	auto& node = getNode(base, offset);
+	element.type = node.type;
+	element.key = getKey();
+	element.keyLength = node.keyLength;
+	element.value = getValue();
+	if(element.value) {
+		element.valueLength = std::min(node.length, uint32_t(UINT16_MAX));
+	}
+	if(node.type == Element::Type::Number) {
+		memcpy(&element.number, &base[offset + headerSize], sizeof(Number));
+	}
+	return element;
+}
+
+/* Dom */
+
+Dom::Dom(char* arena, size_t size)
+{
+	// Align start of arena
+	size_t adjust = (nodeAlign - uintptr_t(arena) % nodeAlign) % nodeAlign;
+	adjust = std::min(adjust, size);
+	this->arena = arena + adjust;
+	capacity = std::min(size - adjust, size_t(UINT32_MAX));
+}
+
+void Dom::reset()
+{
+	used = 0;
+	rootStart = 0;
+	rootCount = 0;
+	depth = 0;
+	segmented = false;
+	full = false;
+}
+
+DomValue Dom::operator[](unsigned index) const
+{
+	return findIndex(begin(), end(), index);
+}
+
+DomValue Dom::operator[](const char* key) const
+{
+	return findKey(begin(), end(), key);
+}
+
+bool Dom::discard()
+{
+	// Keep completed roots only
+	if(depth != 0 || segmented) {
+		--rootCount;
+	}
+	used = rootStart;
+	depth = 0;
+	segmented = false;
+	full = true;
+	return false;
+}
+
+bool Dom::addNode(const Element& element)
+{
+	if(depth == 0) {
+		rootStart = used;
+	}
+
+	bool hasValue = (element.type == Element::Type::Number || element.type == Element::Type::String);
+	uint32_t valueLength = hasValue ? element.valueLength : 0;
+	Node node{0, valueLength, element.keyLength, element.type, 0};
+	auto pos = used;
+	auto end = align(pos + valueOffset(node) + (hasValue ? valueLength + 1 : 0));
+	if(end > capacity) {
+		return discard();
+	}
+
+	if(element.type == Element::Type::Number) {
+		memcpy(&arena[pos + headerSize], &element.number, sizeof(Number));
+	}
+	auto key = &arena[pos + keyOffset(node)];
+	memcpy(key, element.key, node.keyLength);
+	key[node.keyLength] = '\0';
+	if(hasValue) {
+		auto value = &arena[pos + valueOffset(node)];
+		memcpy(value, element.value, valueLength);
+		value[valueLength] = '\0';
+	}
+	if(isContainer(element.type)) {
+		// Set when container ends
+		end = pos + firstItem(node);
+	}
+	node.next = end;
+	getNode(arena, pos) = node;
+	last = pos;
+	used = end;
+
+	if(depth == 0) {
+		++rootCount;
+	} else {
+		++getNode(arena, stack[depth - 1]).length;
+	}
+	return true;
+}
+
+bool Dom::appendSegment(const Element& element)
+{
+	// String being built is always the last node
+	auto& node = getNode(arena, last);
+	auto pos = last + valueOffset(node) + node.length;
+	auto end = align(pos + element.valueLength + 1);
+	if(end > capacity) {
+		return discard();
+	}
+	memcpy(&arena[pos], element.value, element.valueLength);
+	arena[pos + element.valueLength] = '\0';
+	node.length += element.valueLength;
+	node.next = end;
+	used = end;
+	return true;
+}
+
+bool Dom::startElement(const Element& element)
+{
+	if(full) {
+		return false;
+	}
+	bool container = isContainer(element.type);
+	if(container && depth == maxNesting) {
+		return discard();
+	}
+	if(!addNode(element)) {
+		return false;
+	}
+	if(container) {
+		stack[depth++] = last;
+	}
+	return true;
+}
+
+bool Dom::endElement(const Element& element)
+{
+	(void)element;
+	if(full) {
+		return false;
+	}
+	if(depth != 0) {
+		getNode(arena, stack[--depth]).next = used;
+	}
+	return true;
+}
+
+bool Dom::stringSegment(const Element& element, bool final)
+{
+	if(full) {
+		return false;
+	}
+	bool ok = segmented ? appendSegment(element) : addNode(element);
+	segmented = ok && !final;
+	return ok;
+}
+
+} // namespace JSON
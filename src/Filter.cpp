@@ -0,0 +1,7 @@
+#include "include/JSON/Filter.hpp"
+
+namespace JSON
+{
+template class BasicFilter<Listener, Listener>;
+
+} // namespace JSON
@@ -0,0 +1,88 @@
+#include "include/JSON/Index.h"
+
+namespace JSON
+{
+namespace
+{
+uint8_t firstPath(uint32_t matches)
+{
+	uint8_t path{0};
+	while(matches != 0 && (matches & 1) == 0) {
+		matches >>= 1;
+		++path;
+	}
+	return path;
+}
+
+} // namespace
+
+bool IndexBuilder::write(uint8_t path, Element::Type type, size_t start, size_t end)
+{
+	if(end > UINT32_MAX || end < start) {
+		return false;
+	}
+	IndexEntry entry{uint32_t(start), uint32_t(end - start), path, type, 0};
+	if(output.write(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry)) != sizeof(entry)) {
+		return false;
+	}
+	++count;
+	return true;
+}
+
+bool IndexBuilder::Recorder::startElement(const Element& element)
+{
+	bool isContainer = (element.type == Element::Type::Object || element.type == Element::Type::Array);
+	if(inMatch) {
+		// Location of descendants isn't required, so skip their content
+		if(isContainer) {
+			skipElement();
+		}
+		return true;
+	}
+
+	if(!isContainer) {
+		// parseIndexEntry() requires an object or array
+		return true;
+	}
+
+	// End position is known only when the container is closed
+	start = element.offset;
+	level = element.level;
+	path = firstPath(builder.filter.getMatches());
+	type = element.type;
+	inMatch = true;
+	return true;
+}
+
+bool IndexBuilder::Recorder::endElement(const Element& element)
+{
+	if(!inMatch || element.level != level) {
+		return true;
+	}
+
+	inMatch = false;
+	return builder.write(path, type, start, element.endOffset);
+}
+
+bool IndexBuilder::Recorder::stringSegment(const Element&, bool)
+{
+	// Strings aren't indexed
+	return true;
+}
+
+bool findIndexEntry(Stream& index, uint8_t path, unsigned n, IndexEntry& entry)
+{
+	while(index.readBytes(reinterpret_cast<char*>(&entry), sizeof(entry)) == sizeof(entry)) {
+		if(entry.path != path) {
+			continue;
+		}
+		if(n == 0) {
+			return true;
+		}
+		--n;
+	}
+
+	return false;
+}
+
+} // namespace JSON
@@ -0,0 +1,43 @@
+#include "include/JSON/MappedFile.h"
+
+#if defined(ARCH_HOST) && !defined(__WIN32)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace JSON
+{
+MappedFile::MappedFile(const char* filename)
+{
+	int fd = ::open(filename, O_RDONLY);
+	if(fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+		auto addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(addr != MAP_FAILED) {
+			// Content is parsed once from start to end
+			::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+			mapping = static_cast<const char*>(addr);
+			length = st.st_size;
+		}
+	}
+
+	// Mapping remains valid after descriptor is closed
+	::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+	if(mapping != nullptr) {
+		::munmap(const_cast<char*>(mapping), length);
+	}
+}
+
+} // namespace JSON
+
+#endif
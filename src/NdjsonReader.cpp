@@ -0,0 +1,144 @@
+#include "include/JSON/NdjsonReader.h"
+
+#ifdef ARCH_HOST
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace JSON
+{
+void NdjsonReader::parseSlice(const char* data, Slice& slice)
+{
+	slice.listener = createListener(slice);
+	std::unique_ptr<char[]> buffer(new char[bufferSize]);
+	StreamingParser parser(buffer.get(), bufferSize, slice.listener.get());
+	parser.setMultiDocument(true, true);
+	parser.setOffset(slice.offset);
+
+	// Parser takes unsigned block lengths
+	constexpr size_t maxBlockSize{1U << 30};
+	auto status = Status::Ok;
+	for(size_t pos = 0; status == Status::Ok && pos < slice.length;) {
+		auto blockSize = std::min(slice.length - pos, maxBlockSize);
+		status = parser.parse(data + slice.offset + pos, blockSize);
+		pos += blockSize;
+	}
+
+	if(status == Status::Ok) {
+		auto state = parser.getState();
+		bool complete = (state == StreamingParser::State::START_DOCUMENT || state == StreamingParser::State::RECOVER);
+		status = complete ? Status::EndOfDocument : Status::NoMoreData;
+	}
+	slice.documentCount = parser.getDocumentCount();
+	slice.status = status;
+}
+
+Status NdjsonReader::parse(const char* data, size_t length)
+{
+	// Divide input on line boundaries
+	std::vector<Slice> slices;
+	for(size_t pos = 0; pos < length;) {
+		auto end = std::min(pos + std::max(sliceSize, size_t(1)), length);
+		auto newline = static_cast<const char*>(memchr(data + end - 1, '\n', length - end + 1));
+		if(newline != nullptr) {
+			end = newline + 1 - data;
+		} else {
+			end = length;
+		}
+		slices.push_back(Slice{unsigned(slices.size()), pos, end - pos, 0, Status::Ok, nullptr});
+		pos = end;
+	}
+
+	auto count = (threadCount != 0) ? threadCount : std::max(std::thread::hardware_concurrency(), 1U);
+	// Limit number of slices held in memory awaiting delivery
+	const unsigned window = count * 2;
+	std::atomic<unsigned> nextSlice{0};
+	std::atomic<bool> stop{false};
+	unsigned released{0}; ///< Slices delivered, or in ordered mode the index of the next slice to deliver
+	std::mutex mutex;
+	std::condition_variable completed;
+	std::condition_variable delivered;
+	std::deque<unsigned> queue;
+
+	auto worker = [&]() {
+		for(;;) {
+			auto i = nextSlice++;
+			if(i >= slices.size()) {
+				break;
+			}
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				delivered.wait(lock, [&]() { return stop || i < released + window; });
+				if(stop) {
+					break;
+				}
+			}
+			parseSlice(data, slices[i]);
+			std::lock_guard<std::mutex> lock(mutex);
+			queue.push_back(i);
+			completed.notify_one();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for(unsigned i = 0; i < count && i < slices.size(); ++i) {
+		threads.emplace_back(worker);
+	}
+
+	// Deliver results from this thread, so callback needn't be thread-safe
+	auto result = Status::EndOfDocument;
+	unsigned failedSlice = slices.size();
+	auto deliver = [&](Slice& slice) {
+		if(slice.status != Status::EndOfDocument && slice.index < failedSlice) {
+			result = slice.status;
+			failedSlice = slice.index;
+		}
+		bool ok = sliceComplete(slice);
+		slice.listener.reset();
+		if(!ok) {
+			stop = true;
+		}
+	};
+
+	auto release = [&](unsigned count) {
+		std::lock_guard<std::mutex> lock(mutex);
+		released = count;
+		delivered.notify_all();
+	};
+
+	std::vector<bool> ready(slices.size());
+	unsigned nextOrdered{0};
+	for(unsigned completedCount = 0; completedCount < slices.size() && !stop; ++completedCount) {
+		unsigned i;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			completed.wait(lock, [&]() { return !queue.empty(); });
+			i = queue.front();
+			queue.pop_front();
+		}
+		if(!ordered) {
+			deliver(slices[i]);
+			release(completedCount + 1);
+			continue;
+		}
+		ready[i] = true;
+		while(nextOrdered < slices.size() && ready[nextOrdered] && !stop) {
+			deliver(slices[nextOrdered++]);
+		}
+		release(nextOrdered);
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	return stop ? Status::Cancelled : result;
+}
+
+} // namespace JSON
+
+#endif
@@ -0,0 +1,260 @@
+#include "include/JSON/Number.h"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if !JSON_FIXED_POINT && JSON_EISEL_LEMIRE
+#include "PowersOfFive.h"
+#endif
+
+namespace JSON
+{
+namespace
+{
+// Powers of ten which are exactly representable as a double
+constexpr double exactPowersOfTen[]{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+constexpr int maxExactPower{22};
+constexpr uint64_t maxExactMantissa{1ULL << 53};
+
+constexpr uint64_t powersOfTen[]{
+	1ULL,
+	10ULL,
+	100ULL,
+	1000ULL,
+	10000ULL,
+	100000ULL,
+	1000000ULL,
+	10000000ULL,
+	100000000ULL,
+	1000000000ULL,
+	10000000000ULL,
+	100000000000ULL,
+	1000000000000ULL,
+	10000000000000ULL,
+	100000000000000ULL,
+	1000000000000000ULL,
+	10000000000000000ULL,
+	100000000000000000ULL,
+	1000000000000000000ULL,
+	10000000000000000000ULL,
+};
+
+constexpr int maxIntegerPower{19};
+
+#if !JSON_FIXED_POINT && JSON_EISEL_LEMIRE
+
+struct Product {
+	uint64_t high;
+	uint64_t low;
+};
+
+Product multiply(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+	auto result = static_cast<unsigned __int128>(a) * b;
+	return Product{uint64_t(result >> 64), uint64_t(result)};
+#else
+	uint64_t lolo = uint64_t(uint32_t(a)) * uint32_t(b);
+	uint64_t lohi = uint64_t(uint32_t(a)) * (b >> 32);
+	uint64_t hilo = (a >> 32) * uint32_t(b);
+	uint64_t hihi = (a >> 32) * (b >> 32);
+	uint64_t mid = (lolo >> 32) + uint32_t(lohi) + uint32_t(hilo);
+	return Product{hihi + (lohi >> 32) + (hilo >> 32) + (mid >> 32), (mid << 32) | uint32_t(lolo)};
+#endif
+}
+
+/*
+ * Get bit pattern of the double nearest to w * 10^q using the Eisel-Lemire algorithm.
+ * The result is correctly rounded for all w and q.
+ *
+ * See Daniel Lemire, "Number Parsing at a Gigabyte per Second", and Noble Mushtak and Daniel Lemire,
+ * "Fast Number Parsing Without Fallback".
+ */
+uint64_t eiselLemire(uint64_t w, int q)
+{
+	constexpr int mantissaBits{52};
+	constexpr int exponentBias{1023};
+	constexpr int infinitePower{0x7ff};
+	constexpr uint64_t infinity{uint64_t(infinitePower) << mantissaBits};
+
+	if(w == 0 || q < smallestPowerOfFive) {
+		return 0;
+	}
+	if(q > largestPowerOfFive) {
+		return infinity;
+	}
+
+	int lz = __builtin_clzll(w);
+	w <<= lz;
+
+	// Only the high 55 bits of the product are needed. If those might be affected by a carry, refine.
+	auto& power = powersOfFive[q - smallestPowerOfFive];
+	auto product = multiply(w, power.high);
+	constexpr uint64_t precisionMask{~0ULL >> (mantissaBits + 3)};
+	if((product.high & precisionMask) == precisionMask) {
+		auto low = multiply(w, power.low);
+		product.low += low.high;
+		if(low.high > product.low) {
+			++product.high;
+		}
+	}
+
+	int upperBit = int(product.high >> 63);
+	int shift = upperBit + 64 - mantissaBits - 3;
+	uint64_t mantissa = product.high >> shift;
+	// floor(log2(10^q)) + 63, using fixed-point approximation of log2(10)
+	int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperBit - lz + exponentBias;
+
+	if(power2 <= 0) {
+		// Subnormal
+		if(-power2 + 1 >= 64) {
+			return 0;
+		}
+		mantissa >>= -power2 + 1;
+		mantissa += mantissa & 1;
+		mantissa >>= 1;
+		// Rounding up may produce the smallest normal number
+		power2 = (mantissa < (1ULL << mantissaBits)) ? 0 : 1;
+		return mantissa | (uint64_t(power2) << mantissaBits);
+	}
+
+	// Product is exact for small q, so a value exactly halfway between two doubles rounds to even
+	if(product.low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == product.high) {
+		mantissa &= ~1ULL;
+	}
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if(mantissa >= (2ULL << mantissaBits)) {
+		mantissa = 1ULL << mantissaBits;
+		++power2;
+	}
+	mantissa &= ~(1ULL << mantissaBits);
+	if(power2 >= infinitePower) {
+		return infinity;
+	}
+	return mantissa | (uint64_t(power2) << mantissaBits);
+}
+
+#endif
+
+} // namespace
+
+int64_t Decimal::scaled(unsigned digits, bool round) const
+{
+	constexpr auto max = uint64_t(std::numeric_limits<int64_t>::max());
+
+	int shift = exponent + int(digits);
+	uint64_t value;
+	if(shift >= 0) {
+		if(mantissa == 0) {
+			return 0;
+		}
+		if(shift > maxIntegerPower || mantissa > max / powersOfTen[shift]) {
+			value = max;
+		} else {
+			value = mantissa * powersOfTen[shift];
+		}
+	} else if(-shift > maxIntegerPower) {
+		value = 0;
+	} else {
+		auto divisor = powersOfTen[-shift];
+		value = mantissa / divisor;
+		// Round half away from zero
+		if(round && mantissa % divisor >= (divisor + 1) / 2) {
+			++value;
+		}
+	}
+
+	if(value > max) {
+		value = max;
+	}
+	return isNegative ? -int64_t(value) : int64_t(value);
+}
+
+double Decimal::toDouble() const
+{
+	double value = double(mantissa);
+	int exp = exponent;
+	while(exp > maxExactPower) {
+		value *= exactPowersOfTen[maxExactPower];
+		exp -= maxExactPower;
+	}
+	while(exp < -maxExactPower) {
+		value /= exactPowersOfTen[maxExactPower];
+		exp += maxExactPower;
+	}
+	if(exp < 0) {
+		value /= exactPowersOfTen[-exp];
+	} else {
+		value *= exactPowersOfTen[exp];
+	}
+	return isNegative ? -value : value;
+}
+
+#if JSON_FIXED_POINT
+
+Number Number::fromDecimal(const Decimal& decimal, bool isInteger, const char*)
+{
+	Number number;
+	number.decimal = decimal;
+	number.isInteger = isInteger && !decimal.isTruncated && decimal.exponent == 0;
+	return number;
+}
+
+#else
+
+Number Number::fromDecimal(const Decimal& decimal, bool isInteger, const char* text)
+{
+	Number number;
+
+	if(isInteger && !decimal.isTruncated && decimal.exponent == 0) {
+		constexpr auto max = uint64_t(std::numeric_limits<int64_t>::max());
+		if(decimal.mantissa <= max) {
+			number.integer = decimal.isNegative ? -int64_t(decimal.mantissa) : int64_t(decimal.mantissa);
+			return number;
+		}
+		if(decimal.isNegative && decimal.mantissa == max + 1) {
+			number.integer = std::numeric_limits<int64_t>::min();
+			return number;
+		}
+	}
+
+	number.isInteger = false;
+
+	/*
+	 * Fast path: both mantissa and power of ten are exactly representable,
+	 * so a single multiply or divide gives a correctly rounded result.
+	 */
+	if(!decimal.isTruncated && decimal.mantissa <= maxExactMantissa && decimal.exponent >= -maxExactPower &&
+	   decimal.exponent <= maxExactPower) {
+		number.real = decimal.toDouble();
+		return number;
+	}
+
+#if JSON_EISEL_LEMIRE
+	/*
+	 * A truncated mantissa gives a value between w and w + 1 units, so the result is known
+	 * only if both round to the same double.
+	 */
+	auto bits = eiselLemire(decimal.mantissa, decimal.exponent);
+	if(!decimal.isTruncated || bits == eiselLemire(decimal.mantissa + 1, decimal.exponent)) {
+		if(decimal.isNegative) {
+			bits |= 1ULL << 63;
+		}
+		memcpy(&number.real, &bits, sizeof(number.real));
+		return number;
+	}
+#endif
+
+	number.real = text ? strtod(text, nullptr) : 0;
+	return number;
+}
+
+#endif
+
+} // namespace JSON
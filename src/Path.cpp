@@ -0,0 +1,184 @@
+#include "include/JSON/Path.h"
+
+namespace JSON
+{
+namespace
+{
+bool parseIndex(const char* s, unsigned length, uint32_t& index)
+{
+	if(length == 0 || length > 9 || (length > 1 && *s == '0')) {
+		return false;
+	}
+	index = 0;
+	for(unsigned i = 0; i < length; ++i) {
+		if(!isdigit(s[i])) {
+			return false;
+		}
+		index = (index * 10) + (s[i] - '0');
+	}
+	return true;
+}
+
+} // namespace
+
+Path::Path(const char* expr, bool oneShot, uint32_t maxIndex) : expr(expr), oneShot(oneShot)
+{
+	if(expr == nullptr) {
+		valid = false;
+	} else if(*expr == '$') {
+		valid = compilePath(maxIndex);
+	} else {
+		valid = compilePointer(maxIndex);
+	}
+}
+
+bool Path::addStep(Step::Type type, const char* key, unsigned keyLength, uint32_t maxIndex)
+{
+	if(stepCount == maxSteps || keyLength > UINT16_MAX) {
+		return false;
+	}
+	auto& step = steps[stepCount];
+	step = Step{type, 0, uint16_t(key - expr), uint16_t(keyLength), 0};
+	switch(type) {
+	case Step::Type::Index:
+		if(!parseIndex(key, keyLength, step.index) || step.index > maxIndex) {
+			return false;
+		}
+		break;
+	case Step::Type::KeyOrIndex:
+		// Numbers the parser cannot distinguish can still match object keys
+		if(!parseIndex(key, keyLength, step.index) || step.index > maxIndex) {
+			step.type = Step::Type::Key;
+		}
+		step.escaped = memchr(key, '~', keyLength) != nullptr;
+		break;
+	default:;
+	}
+	++stepCount;
+	return true;
+}
+
+bool Path::compilePath(uint32_t maxIndex)
+{
+	auto p = expr + 1;
+	while(*p != '\0') {
+		if(*p == '.') {
+			++p;
+			if(*p == '*') {
+				++p;
+				if(!addStep(Step::Type::Any, p, 0, maxIndex)) {
+					return false;
+				}
+				continue;
+			}
+			auto key = p;
+			while(*p != '\0' && *p != '.' && *p != '[') {
+				++p;
+			}
+			if(p == key || !addStep(Step::Type::Key, key, p - key, maxIndex)) {
+				return false;
+			}
+			continue;
+		}
+
+		if(*p != '[') {
+			return false;
+		}
+		++p;
+		if(*p == '*') {
+			++p;
+			if(!addStep(Step::Type::Any, p, 0, maxIndex)) {
+				return false;
+			}
+		} else if(*p == '\'' || *p == '"') {
+			auto quote = *p++;
+			auto key = p;
+			auto end = strchr(key, quote);
+			if(end == nullptr || !addStep(Step::Type::Key, key, end - key, maxIndex)) {
+				return false;
+			}
+			p = end + 1;
+		} else {
+			auto index = p;
+			while(isdigit(*p)) {
+				++p;
+			}
+			if(!addStep(Step::Type::Index, index, p - index, maxIndex)) {
+				return false;
+			}
+		}
+		if(*p != ']') {
+			return false;
+		}
+		++p;
+	}
+
+	return true;
+}
+
+bool Path::compilePointer(uint32_t maxIndex)
+{
+	// Empty string identifies the whole document
+	auto p = expr;
+	while(*p != '\0') {
+		if(*p != '/') {
+			return false;
+		}
+		auto token = ++p;
+		while(*p != '\0' && *p != '/') {
+			++p;
+		}
+		if(!addStep(Step::Type::KeyOrIndex, token, p - token, maxIndex)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Path::keyMatches(const Step& step, const Element& element) const
+{
+	auto key = expr + step.keyOffset;
+	if(!step.escaped) {
+		return element.keyIs(key, step.keyLength);
+	}
+
+	// Compare whilst decoding JSON Pointer escapes
+	unsigned n = 0;
+	for(unsigned i = 0; i < step.keyLength; ++i, ++n) {
+		char c = key[i];
+		if(c == '~' && i + 1 < step.keyLength) {
+			c = (key[++i] == '1') ? '/' : '~';
+		}
+		if(n == element.keyLength || element.key[n] != c) {
+			return false;
+		}
+	}
+	return n == element.keyLength;
+}
+
+bool Path::matchStep(uint8_t step, const Element& element) const
+{
+	if(step >= stepCount) {
+		return false;
+	}
+
+	auto& s = steps[step];
+	switch(s.type) {
+	case Step::Type::Any:
+		return true;
+	case Step::Type::Key:
+		return element.container.isObject && keyMatches(s, element);
+	case Step::Type::Index:
+		return !element.container.isObject && element.container.index == s.index;
+	case Step::Type::KeyOrIndex:
+		if(element.container.isObject) {
+			return keyMatches(s, element);
+		}
+		return element.container.index == s.index;
+	}
+
+	return false;
+}
+
+} // namespace JSON
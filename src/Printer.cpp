@@ -0,0 +1,79 @@
+#include "include/JSON/Printer.h"
+
+namespace JSON
+{
+bool Printer::writeKey(const Element& element)
+{
+	if(element.level == 0 || !element.container.isObject) {
+		return true;
+	}
+	return writer.key(element.key, element.keyLength) == Status::Ok;
+}
+
+bool Printer::startElement(const Element& element)
+{
+	if(!writeKey(element)) {
+		return false;
+	}
+
+	Status status;
+	switch(element.type) {
+	case Element::Type::Object:
+		status = writer.beginObject();
+		break;
+	case Element::Type::Array:
+		status = writer.beginArray();
+		break;
+	case Element::Type::String:
+		status = writer.value(element.value, element.valueLength);
+		break;
+	default:
+		// Numbers and literals are passed through unchanged
+		status = writer.rawValue(element.value, element.valueLength);
+	}
+	if(status != Status::Ok) {
+		return false;
+	}
+	if(element.level == 0 && element.type != Element::Type::Object && element.type != Element::Type::Array) {
+		return endDocument();
+	}
+	return true;
+}
+
+bool Printer::endElement(const Element& element)
+{
+	auto status = (element.type == Element::Type::Object) ? writer.endObject() : writer.endArray();
+	if(status != Status::Ok) {
+		return false;
+	}
+	return (element.level == 0) ? endDocument() : true;
+}
+
+bool Printer::endDocument()
+{
+	if(writer.flush() != Status::Ok) {
+		return false;
+	}
+	writer.reset();
+	return true;
+}
+
+bool Printer::stringSegment(const Element& element, bool final)
+{
+	if(!segmented) {
+		if(!writeKey(element)) {
+			return false;
+		}
+		segmented = true;
+	}
+	if(writer.stringSegment(element.value, element.valueLength, final) != Status::Ok) {
+		return false;
+	}
+	if(!final) {
+		return true;
+	}
+	segmented = false;
+	return (element.level == 0) ? endDocument() : true;
+}
+
+} // namespace JSON
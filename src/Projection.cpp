@@ -0,0 +1,178 @@
+#include "include/JSON/Projection.h"
+#include <algorithm>
+#include <cstring>
+
+namespace JSON
+{
+Projection::PathSet::PathSet(const Path* paths, uint8_t count)
+	: paths(paths), count(std::min(count, maxPaths)), mask(0)
+{
+	for(unsigned i = 0; i < this->count; ++i) {
+		if(paths[i]) {
+			mask |= 1U << i;
+		}
+	}
+}
+
+uint32_t Projection::PathSet::match(const Element& element, uint32_t& partial) const
+{
+	auto level = element.level;
+	partial = 0;
+	if(level > Path::maxSteps) {
+		return 0;
+	}
+	auto candidates = (level == 0) ? mask : live[level];
+	uint32_t matched{0};
+	for(unsigned i = 0; candidates != 0; ++i, candidates >>= 1) {
+		if((candidates & 1) == 0) {
+			continue;
+		}
+		auto& path = paths[i];
+		if(level > 0 && !path.matchStep(level - 1, element)) {
+			continue;
+		}
+		if(path.getDepth() == level) {
+			matched |= 1U << i;
+		} else {
+			partial |= 1U << i;
+		}
+	}
+	return matched;
+}
+
+Projection::Projection(StreamingWriter& writer, const Path* include, uint8_t includeCount, const Path* exclude,
+					   uint8_t excludeCount)
+	: writer(writer), printer(writer), include(include, includeCount), exclude(exclude, excludeCount)
+{
+}
+
+Projection::Action Projection::select(const Element& element)
+{
+	auto level = element.level;
+	bool isContainer = (element.type == Element::Type::Object || element.type == Element::Type::Array);
+
+	uint32_t excludePartial;
+	if(exclude.match(element, excludePartial) != 0) {
+		return isContainer ? Action::Skip : Action::Discard;
+	}
+
+	if(level == 0) {
+		inInclude = (include.count == 0);
+		includeLevel = 0;
+	}
+
+	uint32_t includePartial{0};
+	bool included = inInclude || include.match(element, includePartial) != 0;
+
+	if(isContainer && level < Path::maxSteps) {
+		exclude.live[level + 1] = excludePartial;
+		if(!inInclude) {
+			include.live[level + 1] = includePartial;
+		}
+	}
+
+	if(included) {
+		if(isContainer && !inInclude) {
+			inInclude = true;
+			includeLevel = level;
+		}
+		return Action::Write;
+	}
+
+	if(level == 0) {
+		// Root container is always written
+		return isContainer ? Action::Write : Action::Discard;
+	}
+
+	if(!isContainer) {
+		return Action::Discard;
+	}
+	return (includePartial == 0) ? Action::Skip : Action::Discard;
+}
+
+bool Projection::saveAncestor(const Element& element)
+{
+	auto level = element.level;
+	uint16_t offset{0};
+	if(level > writer.getLevel()) {
+		auto& parent = ancestors[level - 1];
+		offset = parent.keyOffset + parent.keyLength;
+	}
+	bool hasKey = element.container.isObject;
+	if(hasKey && element.keyLength > unsigned(keyBufferSize - offset)) {
+		return false;
+	}
+	auto& ancestor = ancestors[level];
+	ancestor = Ancestor{offset, 0, hasKey, element.type == Element::Type::Object};
+	if(hasKey) {
+		memcpy(&keys[offset], element.key, element.keyLength);
+		ancestor.keyLength = element.keyLength;
+	}
+	return true;
+}
+
+bool Projection::openAncestors(uint16_t level)
+{
+	for(unsigned i = writer.getLevel(); i < level; ++i) {
+		auto& ancestor = ancestors[i];
+		if(ancestor.hasKey) {
+			writer.key(&keys[ancestor.keyOffset], ancestor.keyLength);
+		}
+		if(ancestor.isObject) {
+			writer.beginObject();
+		} else {
+			writer.beginArray();
+		}
+	}
+	return writer.getStatus() == Status::Ok;
+}
+
+bool Projection::startElement(const Element& element)
+{
+	switch(select(element)) {
+	case Action::Skip:
+		skipElement();
+		return true;
+
+	case Action::Discard:
+		// Containers are pending until something inside them is written
+		if(element.level > 0 && (element.type == Element::Type::Object || element.type == Element::Type::Array)) {
+			return saveAncestor(element);
+		}
+		return true;
+
+	case Action::Write:
+	default:
+		return openAncestors(element.level) && printer.startElement(element);
+	}
+}
+
+bool Projection::endElement(const Element& element)
+{
+	auto level = element.level;
+	if(inInclude && level == includeLevel) {
+		inInclude = false;
+	}
+	if(writer.getLevel() <= level) {
+		// Never opened
+		return true;
+	}
+	return printer.endElement(element);
+}
+
+bool Projection::stringSegment(const Element& element, bool final)
+{
+	if(!inString) {
+		writeString = (select(element) == Action::Write);
+		if(writeString && !openAncestors(element.level)) {
+			return false;
+		}
+		inString = true;
+	}
+	if(final) {
+		inString = false;
+	}
+	return writeString ? printer.stringSegment(element, final) : true;
+}
+
+} // namespace JSON
@@ -0,0 +1,84 @@
+#include "include/JSON/Reader.h"
+#include <algorithm>
+#include <limits>
+
+namespace JSON
+{
+Status Reader::next()
+{
+	if(current + 1 < queue.count) {
+		++current;
+		return Status::Ok;
+	}
+
+	queue.count = 0;
+	current = 0;
+	// Queue pauses the parser after each token, so the caller sees it before any following content is consumed
+	while(status == Status::Ok) {
+		if(input == inputEnd) {
+			return Status::NoMoreData;
+		}
+		unsigned consumed;
+		status = parser.parse(input, std::min<size_t>(inputEnd - input, std::numeric_limits<unsigned>::max()), consumed);
+		input += consumed;
+		if(status == Status::Paused) {
+			status = Status::Ok;
+		}
+		if(queue.count != 0) {
+			return Status::Ok;
+		}
+	}
+
+	return status;
+}
+
+bool Reader::skip()
+{
+	if(current + 1 != queue.count || status != Status::Ok) {
+		return false;
+	}
+	return parser.skipContainer();
+}
+
+void Reader::reset()
+{
+	parser.reset();
+	queue.count = 0;
+	current = 0;
+	status = Status::Ok;
+	input = nullptr;
+	inputEnd = nullptr;
+}
+
+#ifdef __cpp_impl_coroutine
+
+Generator<const Reader::Token&> Reader::tokens(const char* data, size_t length)
+{
+	feed(data, length);
+	while(next() == Status::Ok) {
+		co_yield getToken();
+	}
+}
+
+Generator<const Reader::Token&> Reader::tokens(Stream& stream)
+{
+	char buffer[JSON_STREAM_CHUNK_SIZE];
+	for(;;) {
+		Status res;
+		while((res = next()) == Status::Ok) {
+			co_yield getToken();
+		}
+		if(res != Status::NoMoreData) {
+			break;
+		}
+		auto len = stream.readBytes(buffer, sizeof(buffer));
+		if(len == 0) {
+			break;
+		}
+		feed(buffer, len);
+	}
+}
+
+#endif
+
+} // namespace JSON
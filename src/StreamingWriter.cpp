@@ -0,0 +1,385 @@
+#include "include/JSON/StreamingWriter.h"
+#include "include/JSON/Scan.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+namespace JSON
+{
+namespace
+{
+constexpr char digitPairs[]{
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899"};
+
+// Indentation is written from here, in chunks if necessary
+constexpr char spaces[]{"                                "};
+constexpr unsigned maxSpaces{sizeof(spaces) - 1};
+
+/**
+ * @brief Write decimal digits two at a time, backwards from `end`
+ * @retval char* Position of first digit
+ */
+template <typename T> char* formatDigits(T value, char* end)
+{
+	while(value >= 100) {
+		auto i = unsigned(value % 100) * 2;
+		value /= 100;
+		*--end = digitPairs[i + 1];
+		*--end = digitPairs[i];
+	}
+	if(value >= 10) {
+		auto i = unsigned(value) * 2;
+		*--end = digitPairs[i + 1];
+		*--end = digitPairs[i];
+	} else {
+		*--end = char('0' + value);
+	}
+	return end;
+}
+
+char* formatUnsigned(uint64_t value, char* end)
+{
+	// Avoid 64-bit division where possible
+	if(value <= UINT32_MAX) {
+		return formatDigits(uint32_t(value), end);
+	}
+	return formatDigits(value, end);
+}
+
+} // namespace
+
+Status StreamingWriter::beginValue()
+{
+	if(status != Status::Ok) {
+		return status;
+	}
+	if(inString) {
+		return status = Status::UnexpectedEndOfString;
+	}
+	if(stack.isEmpty()) {
+		if(complete) {
+			status = Status::UnexpectedContentAfterDocument;
+		}
+	} else if(stack.peek().isObject) {
+		if(afterKey) {
+			afterKey = false;
+		} else {
+			status = Status::StringStartExpected;
+		}
+	} else {
+		if(stack.peek().index != 0) {
+			writeChar(',');
+		}
+		writeNewLine();
+		stack.increment();
+	}
+	return status;
+}
+
+Status StreamingWriter::beginContainer(bool isObject)
+{
+	if(beginValue() != Status::Ok) {
+		return status;
+	}
+	if(!stack.push(isObject)) {
+		return status = Status::StackFull;
+	}
+	writeChar(isObject ? '{' : '[');
+	return status;
+}
+
+Status StreamingWriter::endContainer(bool isObject)
+{
+	if(status != Status::Ok) {
+		return status;
+	}
+	if(inString) {
+		return status = Status::UnexpectedEndOfString;
+	}
+	if(stack.isEmpty() || stack.peek().isObject != isObject) {
+		return status = isObject ? Status::NotInObject : Status::NotInArray;
+	}
+	if(afterKey) {
+		return status = Status::BadValue;
+	}
+	if(stack.pop().index != 0) {
+		writeNewLine();
+	}
+	writeChar(isObject ? '}' : ']');
+	endValue();
+	return status;
+}
+
+Status StreamingWriter::beginObject()
+{
+	return beginContainer(true);
+}
+
+Status StreamingWriter::endObject()
+{
+	return endContainer(true);
+}
+
+Status StreamingWriter::beginArray()
+{
+	return beginContainer(false);
+}
+
+Status StreamingWriter::endArray()
+{
+	return endContainer(false);
+}
+
+Status StreamingWriter::key(const char* key, unsigned length)
+{
+	if(status != Status::Ok) {
+		return status;
+	}
+	if(inString) {
+		return status = Status::UnexpectedEndOfString;
+	}
+	if(stack.isEmpty() || !stack.peek().isObject) {
+		return status = Status::NotInObject;
+	}
+	if(afterKey) {
+		return status = Status::BadValue;
+	}
+	if(stack.peek().index != 0) {
+		writeChar(',');
+	}
+	writeNewLine();
+	stack.increment();
+	writeString(key, length);
+	writeChar(':');
+	if(indent != 0) {
+		writeChar(' ');
+	}
+	afterKey = true;
+	return status;
+}
+
+Status StreamingWriter::value(const char* value, unsigned length)
+{
+	if(beginValue() != Status::Ok) {
+		return status;
+	}
+	writeString(value, length);
+	endValue();
+	return status;
+}
+
+Status StreamingWriter::stringSegment(const char* value, unsigned length, bool final)
+{
+	if(!inString) {
+		if(beginValue() != Status::Ok) {
+			return status;
+		}
+		writeChar('"');
+		inString = true;
+	} else if(status != Status::Ok) {
+		return status;
+	}
+	writeEscaped(value, length);
+	if(final) {
+		writeChar('"');
+		inString = false;
+		endValue();
+	}
+	return status;
+}
+
+Status StreamingWriter::integerValue(int64_t number)
+{
+	char text[24];
+	auto end = text + sizeof(text);
+	char* start;
+	if(number < 0) {
+		start = formatUnsigned(0 - uint64_t(number), end);
+		*--start = '-';
+	} else {
+		start = formatUnsigned(uint64_t(number), end);
+	}
+	return rawValue(start, end - start);
+}
+
+Status StreamingWriter::unsignedValue(uint64_t number)
+{
+	char text[24];
+	auto end = text + sizeof(text);
+	auto start = formatUnsigned(number, end);
+	return rawValue(start, end - start);
+}
+
+Status StreamingWriter::value(double number)
+{
+	if(!std::isfinite(number)) {
+		return nullValue();
+	}
+
+	// Integral values are written exactly without involving printf
+	constexpr double maxExactInteger{9007199254740992.0}; // 2^53
+	if(std::fabs(number) < maxExactInteger && number == std::trunc(number)) {
+		return integerValue(int64_t(number));
+	}
+
+	// Use the fewest significant digits which convert back to the same value
+	char text[32];
+	int length{0};
+	for(int precision = 15; precision <= 17; ++precision) {
+		length = snprintf(text, sizeof(text), "%.*g", precision, number);
+		if(strtod(text, nullptr) == number) {
+			break;
+		}
+	}
+	return rawValue(text, length);
+}
+
+Status StreamingWriter::value(const Decimal& number)
+{
+	char text[32];
+	auto end = text + sizeof(text);
+	auto start = end;
+	if(number.exponent != 0) {
+		start = formatUnsigned(std::abs(number.exponent), start);
+		if(number.exponent < 0) {
+			*--start = '-';
+		}
+		*--start = 'e';
+	}
+	start = formatUnsigned(number.mantissa, start);
+	if(number.isNegative) {
+		*--start = '-';
+	}
+	return rawValue(start, end - start);
+}
+
+Status StreamingWriter::rawValue(const char* text, unsigned length)
+{
+	if(beginValue() != Status::Ok) {
+		return status;
+	}
+	writeChars(text, length);
+	endValue();
+	return status;
+}
+
+Status StreamingWriter::flush()
+{
+	if(bufferPos != 0 && status != Status::WriteFailed) {
+		flushBuffer();
+	}
+	return status;
+}
+
+void StreamingWriter::reset()
+{
+	bufferPos = 0;
+	stack.clear();
+	status = Status::Ok;
+	afterKey = false;
+	inString = false;
+	complete = false;
+}
+
+void StreamingWriter::writeChars(const char* data, unsigned length)
+{
+	unsigned space = bufsize - bufferPos;
+	if(length > space) {
+		memcpy(&buffer[bufferPos], data, space);
+		bufferPos = bufsize;
+		data += space;
+		length -= space;
+		flushBuffer();
+		if(length >= bufsize) {
+			// Large content goes straight to output
+			if(output.write(reinterpret_cast<const uint8_t*>(data), length) != length) {
+				status = Status::WriteFailed;
+			}
+			return;
+		}
+	}
+	memcpy(&buffer[bufferPos], data, length);
+	bufferPos += length;
+}
+
+void StreamingWriter::writeEscaped(const char* data, unsigned length)
+{
+	auto end = data + length;
+	while(data < end) {
+		// Copy plain content in one go
+		auto run = Scan::findStringSpecial(data, end);
+		if(run != data) {
+			writeChars(data, run - data);
+			data = run;
+			continue;
+		}
+
+		char c = *data++;
+		char escape;
+		switch(c) {
+		case '"':
+		case '\\':
+			escape = c;
+			break;
+		case '\b':
+			escape = 'b';
+			break;
+		case '\f':
+			escape = 'f';
+			break;
+		case '\n':
+			escape = 'n';
+			break;
+		case '\r':
+			escape = 'r';
+			break;
+		case '\t':
+			escape = 't';
+			break;
+		case 0x7f:
+			// DEL is permitted in JSON strings
+			writeChar(c);
+			continue;
+		default: {
+			char text[]{'\\', 'u', '0', '0', hexchar(uint8_t(c) >> 4), hexchar(c & 0x0f)};
+			writeChars(text, sizeof(text));
+			continue;
+		}
+		}
+		char text[]{'\\', escape};
+		writeChars(text, sizeof(text));
+	}
+}
+
+void StreamingWriter::writeNewLine()
+{
+	if(indent == 0) {
+		return;
+	}
+	writeChar('\n');
+	for(unsigned n = stack.getLevel() * indent; n != 0;) {
+		auto count = std::min(n, maxSpaces);
+		writeChars(spaces, count);
+		n -= count;
+	}
+}
+
+void StreamingWriter::flushBuffer()
+{
+	if(output.write(reinterpret_cast<const uint8_t*>(buffer), bufferPos) != bufferPos) {
+		status = Status::WriteFailed;
+	}
+	bufferPos = 0;
+}
+
+} // namespace JSON
@@ -0,0 +1,131 @@
+#include "include/JSON/StructuralIndex.h"
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace JSON
+{
+namespace
+{
+struct Masks {
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t whitespace;
+	uint64_t structural;
+};
+
+#ifdef __SSE2__
+
+Masks classify(const char* ptr)
+{
+	Masks m{};
+	for(unsigned i = 0; i < 4; ++i) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i * 16));
+		auto eq = [v](char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+		auto ws = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+		auto op = _mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']')));
+		op = _mm_or_si128(op, _mm_or_si128(eq(':'), eq(',')));
+		auto shift = i * 16;
+		m.quote |= uint64_t(uint16_t(_mm_movemask_epi8(eq('"')))) << shift;
+		m.backslash |= uint64_t(uint16_t(_mm_movemask_epi8(eq('\\')))) << shift;
+		m.whitespace |= uint64_t(uint16_t(_mm_movemask_epi8(ws))) << shift;
+		m.structural |= uint64_t(uint16_t(_mm_movemask_epi8(op))) << shift;
+	}
+	return m;
+}
+
+#else
+
+Masks classify(const char* ptr)
+{
+	Masks m{};
+	for(unsigned i = 0; i < StructuralIndex::blockSize; ++i) {
+		uint64_t bit = 1ULL << i;
+		switch(ptr[i]) {
+		case '"':
+			m.quote |= bit;
+			break;
+		case '\\':
+			m.backslash |= bit;
+			break;
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+			m.whitespace |= bit;
+			break;
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ':':
+		case ',':
+			m.structural |= bit;
+			break;
+		default:;
+		}
+	}
+	return m;
+}
+
+#endif
+
+/**
+ * @brief Find characters preceded by an odd number of backslashes
+ */
+uint64_t findEscaped(uint64_t backslash, uint64_t& prevEscaped)
+{
+	constexpr uint64_t evenBits{0x5555555555555555ULL};
+
+	backslash &= ~prevEscaped;
+	uint64_t followsEscape = (backslash << 1) | prevEscaped;
+	uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+	uint64_t sequencesStartingOnEvenBits;
+	prevEscaped = __builtin_add_overflow(oddSequenceStarts, backslash, &sequencesStartingOnEvenBits);
+	uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+	return (evenBits ^ invertMask) & followsEscape;
+}
+
+/**
+ * @brief Each bit becomes the XOR of itself and all lower bits
+ */
+uint64_t prefixXor(uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+} // namespace
+
+void StructuralIndex::scanBlock()
+{
+	auto ptr = data + nextBlock;
+	char tail[blockSize];
+	if(length - nextBlock < blockSize) {
+		// Pad final block with whitespace
+		memset(tail, ' ', blockSize);
+		memcpy(tail, ptr, length - nextBlock);
+		ptr = tail;
+	}
+
+	auto m = classify(ptr);
+	auto quote = m.quote & ~findEscaped(m.backslash, prevEscaped);
+	// Includes opening quote but not closing quote
+	auto inString = prefixXor(quote) ^ prevInString;
+	prevInString = uint64_t(int64_t(inString) >> 63);
+	auto other = ~(m.structural | m.whitespace | m.quote | inString);
+	auto otherStart = other & ~((other << 1) | prevOther);
+	prevOther = other >> 63;
+
+	bits = (m.structural & ~inString) | quote | otherStart;
+	nextBlock += blockSize;
+}
+
+} // namespace JSON
@@ -0,0 +1,7 @@
+#include "include/JSON/StructuralParser.hpp"
+
+namespace JSON
+{
+template class BasicStructuralParser<Listener>;
+
+} // namespace JSON
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "StreamingParser.h"
+
+#ifdef ARCH_HOST
+
+#include <vector>
+
+namespace JSON
+{
+/**
+ * @brief Parses a document consisting of one large array in parallel using a pool of worker threads
+ *
+ * A fast structural scan locates commas between top-level array elements, dividing the content into slices.
+ * The scan runs in its own thread, and each slice is passed to a worker thread as soon as it is found.
+ * The worker parses it as if it were a separate array, recording the elements produced.
+ * These are then passed to the listener in order, with `Element::container.index` and positions adjusted,
+ * so the listener sees the same sequence of calls as from a single parser.
+ *
+ * Content which does not start with an array, or is no larger than one slice, is parsed serially in the calling thread.
+ * If the scan finds a problem with the structure, the remaining content becomes the last slice
+ * so the error is reported as by a serial parse.
+ *
+ * Unlike a single parser, syntax errors are detected within content skipped by the listener.
+ *
+ * Example::
+ *
+ * 	JSON::MappedFile file("export.json");
+ * 	JSON::ArrayReader reader(listener);
+ * 	auto status = reader.parse(file.data(), file.size());
+ *
+ * @note Available for Host builds only.
+ * Child indices are as for a parser using `uint32_t` counters, so are not limited to 255.
+ */
+class ArrayReader
+{
+public:
+	/**
+	 * @brief Maximum nesting depth
+	 */
+	static constexpr unsigned maxNesting{32};
+
+	using Parser = BasicStreamingParser<Listener, maxNesting, uint32_t>;
+
+	ArrayReader(Listener& listener, void* param = nullptr) : listener(listener), param(param)
+	{
+	}
+
+	/**
+	 * @brief Set number of worker threads
+	 * @param count Use 0 for one per available CPU (the default)
+	 */
+	void setThreadCount(unsigned count)
+	{
+		threadCount = count;
+	}
+
+	/**
+	 * @brief Set approximate size of each slice, which is extended to the end of the next array element
+	 */
+	void setSliceSize(size_t size)
+	{
+		sliceSize = size;
+	}
+
+	/**
+	 * @brief Set parser buffer size, which must accommodate the largest key or value
+	 */
+	void setBufferSize(uint16_t size)
+	{
+		bufferSize = size;
+	}
+
+	/**
+	 * @brief Pass keys and string values by reference to the input, see `BasicStreamingParser::setZeroCopy()`
+	 */
+	void setZeroCopy(bool enable)
+	{
+		zeroCopy = enable;
+	}
+
+	/**
+	 * @brief Parse content
+	 * @param data Content, which must remain valid until this call returns
+	 * @param length Number of characters
+	 * @retval Status `Status::EndOfDocument` on success, `Status::NoMoreData` if the content is incomplete,
+	 * otherwise the error as reported by `BasicStreamingParser::parse()`.
+	 */
+	Status parse(const char* data, size_t length);
+
+private:
+	struct Slice {
+		size_t start; ///< Position of opening bracket or separating comma
+		size_t end;	  ///< Position of separating comma, or end of input for the last slice
+		bool last;
+	};
+
+	struct SliceLog;
+	class Recorder;
+	struct ReplayState;
+	class Scanner;
+
+	void parseSlice(const char* data, const Slice& slice, SliceLog& log) const;
+	Status replay(SliceLog& log, ReplayState& state, bool first, bool last);
+	Status parseSerial(const char* data, size_t length);
+
+	Listener& listener;
+	void* param;
+	size_t sliceSize{4 * 1024 * 1024};
+	unsigned threadCount{0};
+	uint16_t bufferSize{1024};
+	bool zeroCopy{false};
+};
+
+} // namespace JSON
+
+#endif
@@ -2,10 +2,13 @@
 
 #include <Print.h>
 #include "Listener.h"
-#include <Data/Format/Standard.h>
+#include <algorithm>
 
 /**
- * @brief Listener implementation to output formatted JSON to a stream
+ * @brief Listener implementation to output a description of each element to a stream
+ *
+ * Writes directly to the output without using the heap.
+ * To re-emit a document as JSON, use `JSON::PrettyPrinter` or `JSON::Minifier`.
  */
 class BasicListener : public JSON::Listener
 {
@@ -21,12 +24,13 @@ public:
 	bool startElement(const Element& element) override
 	{
 		indentLine(element.level);
-		output << (element.container.isObject ? "OBJ" : "ARR") << '(' << element.container.index << ") ";
+		output.print(element.container.isObject ? "OBJ(" : "ARR(");
+		output.print(element.container.index);
+		output.print(") ");
 		if(element.keyLength > 0) {
 			output.write(element.key, element.keyLength);
 			output.print(": ");
 		}
-		String value(element.value, element.valueLength);
 		switch(element.type) {
 		case Element::Type::Object:
 			output.println('{');
@@ -34,13 +38,21 @@ public:
 		case Element::Type::Array:
 			output.println('[');
 			return true;
-		case Element::Type::String:
-			Format::standard.quote(value);
-			[[fallthrough]];
-		default:
-			output << toString(element.type) << " = " << value << endl;
+		default:;
 		}
 
+		output.print(typeName(element.type));
+		output.print(" = ");
+		bool quote = (element.type == Element::Type::String);
+		if(quote) {
+			output.print('"');
+		}
+		output.write(element.value, element.valueLength);
+		if(quote) {
+			output.print('"');
+		}
+		output.println();
+
 		// Continue parsing
 		return true;
 	}
@@ -65,9 +77,26 @@ public:
 	}
 
 private:
+	static const char* typeName(Element::Type type)
+	{
+		switch(type) {
+#define XX(tag)                                                                                                        \
+	case Element::Type::tag:                                                                                           \
+		return #tag;
+			JSON_ELEMENT_TYPE_MAP(XX)
+#undef XX
+		}
+		return "";
+	}
+
 	void indentLine(unsigned level)
 	{
-		output << String().pad(level * 2);
+		static constexpr char spaces[]{"                                "};
+		for(unsigned n = level * 2; n != 0;) {
+			auto count = std::min(n, unsigned(sizeof(spaces) - 1));
+			output.write(spaces, count);
+			n -= count;
+		}
 	}
 
 	Print& output;
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "Listener.h"
+#include "KeyMap.h"
+#include <algorithm>
+
+namespace JSON
+{
+class BindingBase;
+
+/**
+ * @brief Describes how one member of a struct is bound to a JSON key
+ *
+ * Create using `JSON::field()`. The key itself is held by the binding's KeyMap.
+ */
+struct Field {
+	enum class Kind : uint8_t {
+		Value,  ///< Number, boolean or string
+		Object, ///< Nested struct
+		Array,  ///< Fixed-size array of values or structs, with a count
+	};
+
+	Kind kind;
+	const BindingBase* binding; ///< For nested structs, or arrays of structs
+	/**
+	 * @brief Store a value
+	 * @param object Struct containing the member
+	 * @param index For arrays, position of item. Items out of range are ignored.
+	 * @param append Set for second and subsequent string segments
+	 */
+	void (*set)(void* object, unsigned index, const Element& element, bool append);
+	/**
+	 * @brief Get nested struct
+	 * @retval void* nullptr if index is out of range
+	 */
+	void* (*get)(void* object, unsigned index);
+	/**
+	 * @brief Clear array count
+	 */
+	void (*clear)(void* object);
+};
+
+/**
+ * @brief A Field with its key, as returned by `JSON::field()`
+ */
+template <size_t KeySize> struct FieldDef {
+	const char (&key)[KeySize];
+	Field field;
+};
+
+/**
+ * @brief Type-independent part of a Binding, used by the Binder
+ */
+class BindingBase
+{
+public:
+	using Lookup = const Field* (*)(const BindingBase& binding, const Element& element);
+
+	constexpr BindingBase(Lookup lookup) : lookup(lookup)
+	{
+	}
+
+	/**
+	 * @brief Find the field for an element in an object
+	 * @retval const Field* nullptr if key is not bound
+	 */
+	const Field* find(const Element& element) const
+	{
+		return lookup(*this, element);
+	}
+
+private:
+	Lookup lookup;
+};
+
+/**
+ * @brief Table of fields for a struct, with keys hashed at compile time
+ *
+ * Example::
+ *
+ * 	struct Address {
+ * 		char ip[16];
+ * 		uint16_t port;
+ * 	};
+ *
+ * 	struct Config {
+ * 		char ssid[33];
+ * 		uint8_t channel;
+ * 		bool dhcp;
+ * 		Address server;
+ * 		uint8_t channels[8];
+ * 		uint8_t channelCount;
+ * 	};
+ *
+ * 	constexpr auto addressBinding = JSON::makeBinding<Address>(
+ * 		JSON::field<&Address::ip>("ip"),
+ * 		JSON::field<&Address::port>("port"));
+ *
+ * 	constexpr auto configBinding = JSON::makeBinding<Config>(
+ * 		JSON::field<&Config::ssid>("ssid"),
+ * 		JSON::field<&Config::channel>("channel"),
+ * 		JSON::field<&Config::dhcp>("dhcp"),
+ * 		JSON::field<&Config::server>("server", addressBinding),
+ * 		JSON::field<&Config::channels, &Config::channelCount>("channels"));
+ * 	static_assert(configBinding.isValid(), "Duplicate keys");
+ *
+ * @tparam T The struct
+ * @tparam N Number of fields
+ */
+template <typename T, size_t N, size_t TextSize> class Binding : public BindingBase
+{
+public:
+	template <size_t... KeySizes>
+	constexpr Binding(const FieldDef<KeySizes>&... list)
+		: BindingBase(&lookup), fields{list.field...}, keys(list.key...)
+	{
+	}
+
+	/**
+	 * @brief Check keys are unique
+	 */
+	constexpr bool isValid() const
+	{
+		return keys.isValid();
+	}
+
+private:
+	static const Field* lookup(const BindingBase& base, const Element& element)
+	{
+		auto& binding = static_cast<const Binding&>(base);
+		auto index = binding.keys.find(element);
+		return (index < 0) ? nullptr : &binding.fields[index];
+	}
+
+	Field fields[N];
+	KeyMap<N, TextSize> keys;
+};
+
+template <typename T, size_t... KeySizes>
+constexpr Binding<T, sizeof...(KeySizes), (KeySizes + ...)> makeBinding(const FieldDef<KeySizes>&... fields)
+{
+	return Binding<T, sizeof...(KeySizes), (KeySizes + ...)>(fields...);
+}
+
+/**
+ * @brief Functions used by `field()` to access members
+ */
+namespace FieldAccess
+{
+template <typename M> struct MemberTraits;
+
+template <typename C, typename M> struct MemberTraits<M C::*> {
+	using Class = C;
+	using Type = M;
+};
+
+template <typename T> typename std::enable_if<std::is_arithmetic<T>::value>::type setValue(T& dst, const Element& element)
+{
+	// Strings are not converted
+	switch(element.type) {
+	case Element::Type::Number:
+	case Element::Type::True:
+	case Element::Type::False:
+		dst = element.as<T>();
+		break;
+	default:;
+	}
+}
+
+#if JSON_FIXED_POINT
+inline void setValue(Decimal& dst, const Element& element)
+{
+	if(element.type == Element::Type::Number) {
+		dst = element.number.decimal;
+	}
+}
+#endif
+
+/*
+ * Strings are truncated to fit, and always NUL-terminated
+ */
+void setString(char* dst, size_t size, const Element& element, bool append);
+
+template <size_t N> void setValue(char (&dst)[N], const Element& element, bool append = false)
+{
+	setString(dst, N, element, append);
+}
+
+template <typename T> void setValue(T& dst, const Element& element, bool append)
+{
+	(void)append;
+	setValue(dst, element);
+}
+
+template <auto Member> struct Value {
+	using Traits = MemberTraits<decltype(Member)>;
+
+	static void set(void* object, unsigned, const Element& element, bool append)
+	{
+		setValue(static_cast<typename Traits::Class*>(object)->*Member, element, append);
+	}
+
+	static void* get(void* object, unsigned)
+	{
+		return &(static_cast<typename Traits::Class*>(object)->*Member);
+	}
+};
+
+template <auto Member, auto Count> struct Array {
+	using Traits = MemberTraits<decltype(Member)>;
+	using Class = typename Traits::Class;
+	static constexpr size_t capacity{std::extent<typename Traits::Type>::value};
+
+	static void* getItem(Class& object, unsigned index)
+	{
+		if(index >= capacity) {
+			return nullptr;
+		}
+		auto& count = object.*Count;
+		using CountType = typename std::remove_reference<decltype(count)>::type;
+		count = std::max(count, CountType(index + 1));
+		return &(object.*Member)[index];
+	}
+
+	static void set(void* object, unsigned index, const Element& element, bool append)
+	{
+		auto& obj = *static_cast<Class*>(object);
+		if(getItem(obj, index) != nullptr) {
+			setValue((obj.*Member)[index], element, append);
+		}
+	}
+
+	static void* get(void* object, unsigned index)
+	{
+		return getItem(*static_cast<Class*>(object), index);
+	}
+
+	static void clear(void* object)
+	{
+		static_cast<Class*>(object)->*Count = 0;
+	}
+};
+
+} // namespace FieldAccess
+
+/**
+ * @brief Bind a number, boolean or `char[]` string member to a key
+ */
+template <auto Member, size_t KeySize> constexpr FieldDef<KeySize> field(const char (&key)[KeySize])
+{
+	using Access = FieldAccess::Value<Member>;
+	return FieldDef<KeySize>{key, Field{Field::Kind::Value, nullptr, &Access::set, nullptr, nullptr}};
+}
+
+/**
+ * @brief Bind a nested struct member to a key
+ */
+template <auto Member, size_t KeySize>
+constexpr FieldDef<KeySize> field(const char (&key)[KeySize], const BindingBase& binding)
+{
+	using Access = FieldAccess::Value<Member>;
+	return FieldDef<KeySize>{key, Field{Field::Kind::Object, &binding, nullptr, &Access::get, nullptr}};
+}
+
+/**
+ * @brief Bind a fixed-size array of values to a key
+ * @tparam Member The array
+ * @tparam Count Integer member which receives the number of items stored
+ */
+template <auto Member, auto Count, size_t KeySize> constexpr FieldDef<KeySize> field(const char (&key)[KeySize])
+{
+	using Access = FieldAccess::Array<Member, Count>;
+	return FieldDef<KeySize>{key, Field{Field::Kind::Array, nullptr, &Access::set, nullptr, &Access::clear}};
+}
+
+/**
+ * @brief Bind a fixed-size array of structs to a key
+ */
+template <auto Member, auto Count, size_t KeySize>
+constexpr FieldDef<KeySize> field(const char (&key)[KeySize], const BindingBase& binding)
+{
+	using Access = FieldAccess::Array<Member, Count>;
+	return FieldDef<KeySize>{key, Field{Field::Kind::Array, &binding, nullptr, &Access::get, &Access::clear}};
+}
+
+/**
+ * @brief Listener which stores values from a document directly into a struct, as described by a Binding
+ *
+ * Keys are located using the binding's perfect hash. Objects and arrays which are not bound,
+ * or which do not match the type of the bound member, are skipped by the parser without being tokenised.
+ * Members not present in the document are left unchanged, so the struct should be initialised beforehand.
+ * Array items beyond the capacity of the bound array are ignored.
+ * Items are counted by the binder, so arrays are not limited by the parser's `Counter` type.
+ *
+ * Example::
+ *
+ * 	Config config{};
+ * 	JSON::Binder binder(configBinding, config);
+ * 	JSON::StaticStreamingParser<128> parser(&binder);
+ * 	auto status = parser.parse(input);
+ *
+ * Long strings are received in segments, so need not fit into the parser buffer.
+ */
+class Binder : public Listener
+{
+public:
+	/**
+	 * @brief Limit on depth of nested structs and arrays
+	 */
+	static constexpr uint8_t maxNesting{8};
+
+	template <typename T, size_t N, size_t TextSize>
+	Binder(const Binding<T, N, TextSize>& binding, T& object) : binding(binding), object(&object)
+	{
+	}
+
+	/* Listener methods */
+
+	bool startElement(const Element& element) override;
+
+	bool endElement(const Element& element) override;
+
+	bool stringSegment(const Element& element, bool final) override;
+
+private:
+	struct Frame {
+		void* object;
+		const BindingBase* binding; ///< For structs
+		const Field* array;			///< For arrays
+		unsigned itemCount;			///< Number of array items started
+	};
+
+	/*
+	 * Find field for an element. For arrays, set `start` for the first call made for each item.
+	 */
+	const Field* resolve(const Element& element, unsigned& index, bool start);
+	void push(void* object, const BindingBase* binding, const Field* array);
+
+	const BindingBase& binding;
+	void* object;
+	Frame frames[maxNesting];
+	uint8_t depth{0};
+	bool segmented{false};
+};
+
+} // namespace JSON
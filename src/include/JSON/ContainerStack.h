@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Element.h"
+#include <limits>
+#include <cassert>
+
+namespace JSON
+{
+/**
+ * @brief Storage for child counters in a ContainerStack
+ */
+template <unsigned size, typename Counter> class ContainerCounters
+{
+public:
+	static_assert(std::is_unsigned<Counter>::value && sizeof(Counter) <= sizeof(Container::index),
+				  "Counter must be an unsigned type no wider than Container::index");
+
+	uint32_t get(unsigned level) const
+	{
+		return counters[level];
+	}
+
+	void clear(unsigned level)
+	{
+		counters[level] = 0;
+	}
+
+	void increment(unsigned level)
+	{
+		// Saturate rather than wrap
+		if(counters[level] != std::numeric_limits<Counter>::max()) {
+			++counters[level];
+		}
+	}
+
+private:
+	Counter counters[size];
+};
+
+/**
+ * @brief Specialisation for stacks without child counters, where `Container::index` is always 0
+ */
+template <unsigned size> class ContainerCounters<size, void>
+{
+public:
+	uint32_t get(unsigned) const
+	{
+		return 0;
+	}
+
+	void clear(unsigned)
+	{
+	}
+
+	void increment(unsigned)
+	{
+	}
+};
+
+/**
+ * @brief Nesting stack storing one bit per level for the container type, plus optional child counters
+ * @tparam size Maximum nesting depth
+ * @tparam Counter Type used to count children at each level, saturating at its maximum value.
+ * Use `uint32_t` for large arrays, or `void` if `Container::index` isn't required.
+ */
+template <unsigned size, typename Counter = uint8_t> class ContainerStack
+{
+public:
+	static_assert(size > 0 && size <= UINT16_MAX, "Invalid ContainerStack size");
+
+	static constexpr unsigned maxNesting{size};
+
+	bool push(bool isObject)
+	{
+		if(level == size) {
+			return false;
+		}
+		auto& word = objectBits[level / 32];
+		auto mask = 1U << (level % 32);
+		if(isObject) {
+			word |= mask;
+		} else {
+			word &= ~mask;
+		}
+		counters.clear(level);
+		++level;
+		return true;
+	}
+
+	Container peek() const
+	{
+		assert(level > 0);
+		return get(level - 1);
+	}
+
+	/**
+	 * @brief Increment child counter for current container
+	 */
+	void increment()
+	{
+		assert(level > 0);
+		counters.increment(level - 1);
+	}
+
+	Container pop()
+	{
+		assert(level > 0);
+		--level;
+		return get(level);
+	}
+
+	bool isEmpty() const
+	{
+		return level == 0;
+	}
+
+	uint16_t getLevel() const
+	{
+		return level;
+	}
+
+	void clear()
+	{
+		level = 0;
+	}
+
+private:
+	Container get(unsigned i) const
+	{
+		return Container{(objectBits[i / 32] & (1U << (i % 32))) != 0, counters.get(i)};
+	}
+
+	uint32_t objectBits[(size + 31) / 32];
+	ContainerCounters<size, Counter> counters;
+	uint16_t level{0}; ///< Points to next level, so 0 indicates an empty stack
+};
+
+} // namespace JSON
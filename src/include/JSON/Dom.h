@@ -0,0 +1,269 @@
+#pragma once
+
+#include "Listener.h"
+
+namespace JSON
+{
+/**
+ * @brief Read-only reference to a value stored in a Dom
+ *
+ * A default-constructed (or not found) value is invalid, and all lookups on it return invalid values,
+ * so chained lookups need only be checked at the end::
+ *
+ * 	auto port = dom["config"]["server"]["port"].as<uint16_t>();
+ */
+class DomValue
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const char* base, uint32_t offset, uint32_t remaining)
+			: base(base), offset(offset), remaining(remaining)
+		{
+		}
+
+		DomValue operator*() const
+		{
+			return DomValue(base, offset);
+		}
+
+		Iterator& operator++();
+
+		bool operator==(const Iterator& other) const
+		{
+			return remaining == other.remaining;
+		}
+
+		bool operator!=(const Iterator& other) const
+		{
+			return remaining != other.remaining;
+		}
+
+	private:
+		const char* base;
+		uint32_t offset;
+		uint32_t remaining;
+	};
+
+	DomValue() = default;
+
+	DomValue(const char* base, uint32_t offset) : base(base), offset(offset)
+	{
+	}
+
+	explicit operator bool() const
+	{
+		return base != nullptr;
+	}
+
+	Element::Type getType() const;
+
+	bool isContainer() const
+	{
+		auto type = getType();
+		return type == Element::Type::Object || type == Element::Type::Array;
+	}
+
+	/**
+	 * @brief Get key, NUL-terminated
+	 */
+	const char* getKey() const;
+
+	uint16_t getKeyLength() const;
+
+	bool keyIs(const char* key, unsigned length) const;
+
+	bool keyIs(const char* key) const
+	{
+		return keyIs(key, strlen(key));
+	}
+
+	/**
+	 * @brief Get text of a string or number, NUL-terminated
+	 * @retval const char* nullptr for other types
+	 */
+	const char* getValue() const;
+
+	uint32_t getValueLength() const;
+
+	/**
+	 * @brief Get number of items in an object or array
+	 */
+	uint32_t size() const;
+
+	/**
+	 * @brief Find member of an object
+	 */
+	DomValue operator[](const char* key) const;
+
+	/**
+	 * @brief Get item of an array or object by position
+	 */
+	DomValue operator[](unsigned index) const;
+
+	DomValue operator[](int index) const
+	{
+		return (*this)[unsigned(index)];
+	}
+
+	/**
+	 * @brief Iterate over items of an object or array
+	 */
+	Iterator begin() const;
+
+	Iterator end() const
+	{
+		return Iterator(base, 0, 0);
+	}
+
+	/**
+	 * @brief Describe value as an Element
+	 * @note Element is limited to 65535 characters
+	 */
+	Element getElement() const;
+
+	/**
+	 * @brief Get value with conversion, as for `Element::as()`
+	 */
+	template <typename T> T as() const
+	{
+		return getElement().as<T>();
+	}
+
+private:
+	const char* base{nullptr};
+	uint32_t offset{0};
+};
+
+/**
+ * @brief Listener which builds a compact, read-only DOM in a fixed-size arena
+ *
+ * Nodes are laid out in document order (tape layout), each followed directly by its key and value.
+ * Every object and array records the position of the following sibling, so content can be stepped over
+ * without visiting it. No other memory is used.
+ *
+ * All elements passed to the listener are stored. To materialise only selected subtrees from a larger
+ * document, use it as the target of a `JSON::Filter`::
+ *
+ * 	JSON::StaticDom<2048> dom;
+ * 	JSON::Path paths[]{{"$.config", true}};
+ * 	JSON::Filter filter(dom, paths, ARRAY_SIZE(paths));
+ * 	JSON::StaticStreamingParser<128> parser(&filter);
+ * 	parser.parse(input);
+ * 	auto ssid = dom["config"]["wifi"]["ssid"].getValue();
+ *
+ * Each subtree passed to the listener becomes a root value. Roots retain their original key, if any.
+ *
+ * When the arena is full, the incomplete subtree is discarded and parsing is cancelled.
+ * Subtrees already completed remain available.
+ */
+class Dom : public Listener
+{
+public:
+	/**
+	 * @brief Limit on nesting within a subtree
+	 */
+	static constexpr uint8_t maxNesting{32};
+
+	/**
+	 * @brief Constructor
+	 * @param arena Storage for the DOM
+	 * @param size Size of arena in bytes
+	 */
+	Dom(char* arena, size_t size);
+
+	/**
+	 * @brief Discard content
+	 */
+	void reset();
+
+	/**
+	 * @brief Get number of root values
+	 */
+	uint32_t size() const
+	{
+		return rootCount;
+	}
+
+	/**
+	 * @brief Get root value by position
+	 */
+	DomValue operator[](unsigned index) const;
+
+	DomValue operator[](int index) const
+	{
+		return (*this)[unsigned(index)];
+	}
+
+	/**
+	 * @brief Get root value by its original key
+	 */
+	DomValue operator[](const char* key) const;
+
+	DomValue::Iterator begin() const
+	{
+		return DomValue::Iterator(arena, 0, rootCount);
+	}
+
+	DomValue::Iterator end() const
+	{
+		return DomValue::Iterator(arena, 0, 0);
+	}
+
+	/**
+	 * @brief Get number of bytes of arena in use
+	 */
+	size_t getUsed() const
+	{
+		return used;
+	}
+
+	/**
+	 * @brief Determine if content was discarded because the arena was full
+	 */
+	bool isFull() const
+	{
+		return full;
+	}
+
+	/* Listener methods */
+
+	bool startElement(const Element& element) override;
+
+	bool endElement(const Element& element) override;
+
+	bool stringSegment(const Element& element, bool final) override;
+
+private:
+	bool addNode(const Element& element);
+	bool appendSegment(const Element& element);
+	bool discard();
+
+	char* arena;
+	uint32_t capacity;
+	uint32_t used{0};
+	uint32_t rootStart{0}; ///< Position of root value being built
+	uint32_t last{0};	  ///< Position of last node added
+	uint32_t rootCount{0};
+	uint32_t stack[maxNesting]; ///< Positions of open containers
+	uint8_t depth{0};
+	bool segmented{false};
+	bool full{false};
+};
+
+/**
+ * @brief Dom with internal arena
+ */
+template <size_t SIZE> class StaticDom : public Dom
+{
+public:
+	StaticDom() : Dom(arena, SIZE)
+	{
+	}
+
+private:
+	alignas(8) char arena[SIZE];
+};
+
+} // namespace JSON
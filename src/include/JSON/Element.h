@@ -26,6 +26,7 @@ See more at http://blog.squix.ch and https://github.com/squix78/json-streaming-p
 #pragma once
 
 #include <WString.h>
+#include "Number.h"
 
 #define JSON_ELEMENT_TYPE_MAP(XX)                                                                                      \
 	XX(Null)                                                                                                           \
@@ -42,12 +43,10 @@ namespace JSON
  * @brief Identifies type and position of item in a parent object or array
  */
 struct Container {
-	uint8_t isObject : 1; ///< Can only be an object or an array
-	uint8_t index : 7;	///< Counts child items
+	bool isObject;	///< Can only be an object or an array
+	uint32_t index; ///< Position of item within container, limited by parser's counter type
 };
 
-static_assert(sizeof(Container) == 1, "Container size incorrect");
-
 struct Element {
 	enum class Type : uint8_t {
 #define XX(t) t,
@@ -58,11 +57,16 @@ struct Element {
 	void* param{nullptr};
 	Container container{true, 0};
 	Type type = Type::Null;
-	uint8_t level{0}; ///< Nesting level
+	uint16_t level{0}; ///< Nesting level
 	const char* key{nullptr};
 	const char* value{nullptr};
 	uint16_t keyLength{0};
 	uint16_t valueLength{0};
+	bool keyIsView{false};	 ///< Key refers directly to parser input so is not NUL-terminated
+	bool valueIsView{false}; ///< Value refers directly to parser input so is not NUL-terminated
+	Number number; ///< Decoded value for Type::Number
+	size_t offset{0};	 ///< Position in input of first character of value. Not set by `endElement()`.
+	size_t endOffset{0}; ///< Position following value. For objects and arrays, set only by `endElement()`.
 
 	String getKey() const
 	{
@@ -122,7 +126,8 @@ struct Element {
 		}
 	}
 
-	template <typename T> inline typename std::enable_if<std::is_integral<T>::value, T>::type as() const
+	template <typename T>
+	inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, T>::type as() const
 	{
 		switch(type) {
 		case Type::Null:
@@ -134,6 +139,7 @@ struct Element {
 		case Type::False:
 			return 0;
 		case Type::Number:
+			return number.as<T>();
 		case Type::String:
 		default:
 			return value ? atoll(value) : 0;
@@ -152,12 +158,27 @@ struct Element {
 		case Type::False:
 			return 0;
 		case Type::Number:
+			return number.as<T>();
 		case Type::String:
 		default:
 			return value ? atof(value) : 0;
 		}
 	}
 
+#if JSON_FIXED_POINT
+	template <typename T> inline typename std::enable_if<std::is_same<T, Decimal>::value, T>::type as() const
+	{
+		switch(type) {
+		case Type::Number:
+			return number.decimal;
+		case Type::True:
+			return Decimal{1};
+		default:
+			return Decimal{};
+		}
+	}
+#endif
+
 	template <typename T> inline typename std::enable_if<std::is_same<T, bool>::value, T>::type as() const
 	{
 		switch(type) {
@@ -170,7 +191,7 @@ struct Element {
 		case Type::False:
 			return false;
 		case Type::Number:
-			return as<int>() != 0;
+			return !number.isZero();
 		case Type::String:
 		default:
 			return valueLength != 0;
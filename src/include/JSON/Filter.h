@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Listener.h"
+#include "Path.h"
+
+namespace JSON
+{
+/**
+ * @brief Listener which passes only elements identified by a set of paths to another listener
+ * @tparam TargetT Type of listener receiving matching elements
+ * @tparam BaseT Use `ListenerBase` so the filter can be the parser's `ListenerT`, or `Listener` for a virtual interface
+ *
+ * When an element matches, it is passed to the target listener together with all of its
+ * descendants. All other elements are discarded, and objects or arrays which cannot contain
+ * a match are skipped by the parser without being tokenised.
+ *
+ * If all paths are one-shot then parsing stops with `Status::Cancelled` as soon as each has been
+ * matched once, so the remainder of the document need not be read.
+ *
+ * Example::
+ *
+ * 	JSON::Path paths[]{
+ * 		{"$.items[*].id"},
+ * 		{"/meta/total", true},
+ * 	};
+ * 	JSON::Filter filter(listener, paths, ARRAY_SIZE(paths));
+ * 	JSON::StaticStreamingParser<128> parser(&filter);
+ *
+ * `Filter` uses virtual methods. For large documents where few elements match, use static dispatch
+ * so discarded elements cost no virtual call::
+ *
+ * 	using MyFilter = JSON::BasicFilter<MyListener>;
+ * 	MyFilter filter(listener, paths, ARRAY_SIZE(paths));
+ * 	JSON::StaticStreamingParser<128, MyFilter> parser(&filter);
+ */
+template <class TargetT = Listener, class BaseT = ListenerBase> class BasicFilter : public BaseT
+{
+public:
+	using ParserListener = BasicFilter;
+
+	/**
+	 * @brief Maximum number of paths which may be matched
+	 */
+	static constexpr uint8_t maxPaths{32};
+
+	/**
+	 * @brief Constructor
+	 * @param target Receives matching elements
+	 * @param paths Array of paths to match. Invalid paths are ignored.
+	 * @param pathCount Number of paths in array
+	 */
+	BasicFilter(TargetT& target, const Path* paths, uint8_t pathCount);
+
+	/**
+	 * @brief Prepare to filter another document
+	 */
+	void reset();
+
+	/**
+	 * @brief Get the paths which matched the element currently being passed to the target listener
+	 * @retval uint32_t Bit mask of indices into paths array
+	 */
+	uint32_t getMatches() const
+	{
+		return matches;
+	}
+
+	/**
+	 * @brief Determine whether all one-shot paths have been satisfied
+	 */
+	bool isComplete() const
+	{
+		return active == 0;
+	}
+
+	/* Listener methods */
+
+	bool startElement(const Element& element);
+
+	bool endElement(const Element& element);
+
+	bool stringSegment(const Element& element, bool final);
+
+private:
+	uint32_t getCandidates(const Element& element, uint32_t& partial) const;
+	void complete(uint32_t mask);
+
+	/*
+	 * Pass a pause request from the target to the parser
+	 */
+	bool forwardPause(bool ok)
+	{
+		if(target.checkPause()) {
+			this->pause();
+		}
+		return ok;
+	}
+
+	TargetT& target;
+	const Path* paths;
+	uint8_t pathCount;
+	uint32_t active{0};  ///< Paths still to be matched
+	uint32_t matches{0}; ///< Paths which matched current subtree
+	uint32_t live[Path::maxSteps + 1]; ///< Paths whose ancestors match, by level
+	uint16_t matchLevel{0};
+	bool inMatch{false};
+};
+
+using Filter = BasicFilter<Listener, Listener>;
+
+extern template class BasicFilter<Listener, Listener>;
+
+} // namespace JSON
+
+#include "Filter.hpp"
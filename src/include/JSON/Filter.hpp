@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Filter.h"
+#include <algorithm>
+
+namespace JSON
+{
+template <class TargetT, class BaseT>
+BasicFilter<TargetT, BaseT>::BasicFilter(TargetT& target, const Path* paths, uint8_t pathCount)
+	: target(target), paths(paths), pathCount(std::min(pathCount, maxPaths))
+{
+	reset();
+}
+
+template <class TargetT, class BaseT>
+void BasicFilter<TargetT, BaseT>::reset()
+{
+	active = 0;
+	for(unsigned i = 0; i < pathCount; ++i) {
+		if(paths[i]) {
+			active |= 1U << i;
+		}
+	}
+	matches = 0;
+	inMatch = false;
+}
+
+template <class TargetT, class BaseT>
+uint32_t BasicFilter<TargetT, BaseT>::getCandidates(const Element& element, uint32_t& partial) const
+{
+	auto level = element.level;
+	partial = 0;
+	if(level > Path::maxSteps) {
+		return 0;
+	}
+	// Paths completed since the container was entered are excluded
+	auto candidates = (level == 0) ? active : (live[level] & active);
+	uint32_t matched{0};
+	for(unsigned i = 0; candidates != 0; ++i, candidates >>= 1) {
+		if((candidates & 1) == 0) {
+			continue;
+		}
+		auto& path = paths[i];
+		if(level > 0 && !path.matchStep(level - 1, element)) {
+			continue;
+		}
+		if(path.getDepth() == level) {
+			matched |= 1U << i;
+		} else {
+			partial |= 1U << i;
+		}
+	}
+	return matched;
+}
+
+template <class TargetT, class BaseT>
+void BasicFilter<TargetT, BaseT>::complete(uint32_t mask)
+{
+	for(unsigned i = 0; mask != 0; ++i, mask >>= 1) {
+		if((mask & 1) && paths[i].isOneShot()) {
+			active &= ~(1U << i);
+		}
+	}
+}
+
+template <class TargetT, class BaseT>
+bool BasicFilter<TargetT, BaseT>::startElement(const Element& element)
+{
+	if(inMatch) {
+		bool ok = forwardPause(target.startElement(element));
+		if(target.checkSkip()) {
+			this->skipElement();
+		}
+		return ok;
+	}
+
+	uint32_t partial;
+	auto matched = getCandidates(element, partial);
+	bool isContainer = (element.type == Element::Type::Object || element.type == Element::Type::Array);
+	if(isContainer && element.level < Path::maxSteps) {
+		live[element.level + 1] = partial;
+	}
+
+	if(matched == 0) {
+		if(isContainer && partial == 0) {
+			// Nothing of interest here
+			this->skipElement();
+		}
+		return true;
+	}
+
+	matches = matched;
+	if(isContainer) {
+		bool ok = forwardPause(target.startElement(element));
+		if(!target.checkSkip()) {
+			matchLevel = element.level;
+			inMatch = true;
+			return ok;
+		}
+		this->skipElement();
+		complete(matched);
+		return ok && !isComplete();
+	}
+
+	bool ok = forwardPause(target.startElement(element));
+	complete(matched);
+	return ok && !isComplete();
+}
+
+template <class TargetT, class BaseT>
+bool BasicFilter<TargetT, BaseT>::endElement(const Element& element)
+{
+	if(!inMatch) {
+		return true;
+	}
+
+	bool ok = forwardPause(target.endElement(element));
+	if(element.level == matchLevel) {
+		inMatch = false;
+		complete(matches);
+		ok = ok && !isComplete();
+	}
+	return ok;
+}
+
+template <class TargetT, class BaseT>
+bool BasicFilter<TargetT, BaseT>::stringSegment(const Element& element, bool final)
+{
+	if(inMatch) {
+		return forwardPause(target.stringSegment(element, final));
+	}
+
+	uint32_t partial;
+	auto matched = getCandidates(element, partial);
+	if(matched == 0) {
+		// Discard
+		return true;
+	}
+
+	matches = matched;
+	bool ok = forwardPause(target.stringSegment(element, final));
+	if(final) {
+		complete(matched);
+		ok = ok && !isComplete();
+	}
+	return ok;
+}
+
+} // namespace JSON
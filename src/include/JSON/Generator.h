@@ -0,0 +1,135 @@
+#pragma once
+
+#ifdef __cpp_impl_coroutine
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace JSON
+{
+/**
+ * @brief Minimal generator for use with C++20 coroutines
+ *
+ * Each value is produced by the coroutine as the generator is iterated, for example::
+ *
+ * 	for(auto& token : reader.tokens(data, length)) {
+ * 		...
+ * 	}
+ *
+ * @tparam T Type yielded, usually a reference. Referenced values remain valid until the iterator is advanced.
+ * @note Available only when compiled with coroutine support, such as `-std=c++20`
+ */
+template <typename T> class Generator
+{
+public:
+	using value_type = std::remove_reference_t<T>;
+
+	struct promise_type {
+		value_type* value{nullptr};
+
+		Generator get_return_object()
+		{
+			return Generator{Handle::from_promise(*this)};
+		}
+
+		std::suspend_always initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		std::suspend_always final_suspend() noexcept
+		{
+			return {};
+		}
+
+		std::suspend_always yield_value(value_type& v) noexcept
+		{
+			value = std::addressof(v);
+			return {};
+		}
+
+		void return_void()
+		{
+		}
+
+		void unhandled_exception()
+		{
+			std::terminate();
+		}
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	class Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Generator::value_type;
+
+		explicit Iterator(Handle handle) : handle(handle)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			handle.resume();
+			return *this;
+		}
+
+		T operator*() const
+		{
+			return *handle.promise().value;
+		}
+
+		bool operator==(std::default_sentinel_t) const
+		{
+			return !handle || handle.done();
+		}
+
+	private:
+		Handle handle;
+	};
+
+	explicit Generator(Handle handle) : handle(handle)
+	{
+	}
+
+	Generator(Generator&& other) noexcept : handle(other.handle)
+	{
+		other.handle = nullptr;
+	}
+
+	Generator(const Generator&) = delete;
+	Generator& operator=(const Generator&) = delete;
+
+	~Generator()
+	{
+		if(handle) {
+			handle.destroy();
+		}
+	}
+
+	Iterator begin()
+	{
+		if(handle) {
+			handle.resume();
+		}
+		return Iterator{handle};
+	}
+
+	std::default_sentinel_t end()
+	{
+		return {};
+	}
+
+private:
+	Handle handle;
+};
+
+} // namespace JSON
+
+#endif
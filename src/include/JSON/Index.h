@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Filter.h"
+#include "StreamingParser.h"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace JSON
+{
+/**
+ * @brief Location of an element within a document, as stored in an index
+ * @note Stored in native byte order
+ */
+struct IndexEntry {
+	uint32_t offset;	///< Position of first character of element
+	uint32_t length;	///< Number of characters in element
+	uint8_t path;		///< Index of matching path
+	Element::Type type; ///< Type of element
+	uint16_t reserved;
+};
+
+static_assert(sizeof(IndexEntry) == 12, "Bad IndexEntry size");
+
+/**
+ * @brief Listener which writes the location of elements identified by a set of paths to an index
+ *
+ * The index is a sequence of `IndexEntry` records. Once built, elements may be retrieved from
+ * the original document using `findIndexEntry()` and `parseIndexEntry()` without parsing
+ * anything else.
+ *
+ * Example::
+ *
+ * 	JSON::Path paths[]{
+ * 		{"$.items[*]"},
+ * 	};
+ * 	JSON::IndexBuilder builder(indexFile, paths, ARRAY_SIZE(paths));
+ * 	JSON::StaticStreamingParser<128> parser(&builder);
+ * 	parser.parse(documentFile);
+ *
+ * Only objects and arrays are indexed, as `parseIndexEntry()` must start at one of these.
+ * Paths matching numbers, strings and other values produce no entries.
+ * The content of matching objects and arrays is skipped, so nested matches are not indexed.
+ */
+class IndexBuilder : public Listener
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param output Where to write index entries
+	 * @param paths Array of paths to index
+	 * @param pathCount Number of paths in array
+	 */
+	IndexBuilder(Print& output, const Path* paths, uint8_t pathCount)
+		: recorder(*this), filter(recorder, paths, pathCount), output(output)
+	{
+	}
+
+	/**
+	 * @brief Prepare to index another document
+	 */
+	void reset()
+	{
+		filter.reset();
+		recorder.inMatch = false;
+		count = 0;
+	}
+
+	/**
+	 * @brief Get number of entries written
+	 */
+	unsigned getCount() const
+	{
+		return count;
+	}
+
+	/* Listener methods */
+
+	bool startElement(const Element& element) override
+	{
+		bool ok = filter.startElement(element);
+		if(filter.checkSkip()) {
+			skipElement();
+		}
+		return forwardPause(ok);
+	}
+
+	bool endElement(const Element& element) override
+	{
+		return forwardPause(filter.endElement(element));
+	}
+
+	bool stringSegment(const Element& element, bool final) override
+	{
+		return forwardPause(filter.stringSegment(element, final));
+	}
+
+private:
+	/**
+	 * @brief Receives matching elements from the filter
+	 */
+	class Recorder : public ListenerBase
+	{
+	public:
+		Recorder(IndexBuilder& builder) : builder(builder)
+		{
+		}
+
+		bool startElement(const Element& element);
+		bool endElement(const Element& element);
+		bool stringSegment(const Element& element, bool final);
+
+		IndexBuilder& builder;
+		size_t start{0};
+		uint16_t level{0};
+		uint8_t path{0};
+		Element::Type type{};
+		bool inMatch{false};
+	};
+
+	bool write(uint8_t path, Element::Type type, size_t start, size_t end);
+
+	bool forwardPause(bool ok)
+	{
+		if(filter.checkPause()) {
+			pause();
+		}
+		return ok;
+	}
+
+	Recorder recorder;
+	BasicFilter<Recorder> filter;
+	Print& output;
+	unsigned count{0};
+};
+
+/**
+ * @brief Search an index for an entry
+ * @param index Stream containing index written by `IndexBuilder`, read from the current position
+ * @param path Index of path to search for
+ * @param n Number of matching entries to pass over first, e.g. 0 for the first match
+ * @param entry On success, the entry found
+ * @retval bool true if entry was found
+ */
+bool findIndexEntry(Stream& index, uint8_t path, unsigned n, IndexEntry& entry);
+
+/**
+ * @brief Parse a single indexed object or array from a document
+ * @param parser Parser to use, which is reset first
+ * @param document Stream containing the document from which the index was built
+ * @param entry Location of element
+ * @retval Status `Status::EndOfDocument` on success.
+ * Element offsets passed to the listener are relative to the start of the whole document.
+ */
+template <class Parser> Status parseIndexEntry(Parser& parser, IDataSourceStream& document, const IndexEntry& entry)
+{
+	if(document.seekFrom(entry.offset, SeekOrigin::Start) != int(entry.offset)) {
+		return Status::NoMoreData;
+	}
+
+	parser.reset();
+	parser.setOffset(entry.offset);
+	char buffer[JSON_STREAM_CHUNK_SIZE];
+	auto remain = entry.length;
+	while(remain != 0) {
+		auto len = document.readBytes(buffer, std::min(size_t(remain), sizeof(buffer)));
+		if(len == 0) {
+			return Status::NoMoreData;
+		}
+		auto status = parser.parse(buffer, len);
+		if(status != Status::Ok) {
+			return status;
+		}
+		remain -= len;
+	}
+
+	return Status::NoMoreData;
+}
+
+} // namespace JSON
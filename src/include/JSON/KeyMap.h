@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Element.h"
+#include <sys/pgmspace.h>
+
+namespace JSON
+{
+/**
+ * @brief Perfect hash of a fixed set of keys, generated at compile time
+ *
+ * Maps a key to its position in the list with one hash calculation and one comparison,
+ * instead of comparing against each candidate in turn.
+ *
+ * Example::
+ *
+ * 	enum class Field { name, id, value };
+ * 	static constexpr auto fields = JSON::makeKeyMap("name", "id", "value");
+ * 	static_assert(fields.isValid(), "Duplicate keys");
+ *
+ * 	bool startElement(const JSON::Element& element) override
+ * 	{
+ * 		switch(Field(fields.find(element))) {
+ * 		case Field::name:
+ * 			...
+ * 		}
+ * 	}
+ *
+ * The key text is copied into the map, so the literals are not referenced at runtime.
+ * All tables are read using flash-safe accessors, so on ESP8266 the map may be kept in flash::
+ *
+ * 	static constexpr auto fields PROGMEM = JSON::makeKeyMap("name", "id", "value");
+ *
+ * @tparam N Number of keys
+ * @tparam TextSize Total size of keys, including NUL terminators
+ */
+template <size_t N, size_t TextSize> class KeyMap
+{
+public:
+	static_assert(N > 0 && N < 255, "KeyMap supports 1 to 254 keys");
+	static_assert(TextSize <= UINT16_MAX, "KeyMap text too large");
+
+	/**
+	 * @brief Hash used to identify keys
+	 */
+	static constexpr uint32_t hash(const char* key, unsigned length)
+	{
+		// FNV-1a
+		uint32_t h{2166136261U};
+		for(unsigned i = 0; i < length; ++i) {
+			h = (h ^ uint8_t(key[i])) * 16777619U;
+		}
+		return h;
+	}
+
+	template <size_t... KeySizes> constexpr KeyMap(const char (&... keyList)[KeySizes])
+	{
+		static_assert(sizeof...(KeySizes) == N, "Wrong number of keys");
+		static_assert((KeySizes + ...) == TextSize, "Wrong text size");
+		unsigned i{0};
+		(addKey(i++, keyList, KeySizes - 1), ...);
+		valid = build();
+	}
+
+	/**
+	 * @brief Check map was built successfully, i.e. keys are unique
+	 */
+	constexpr bool isValid() const
+	{
+		return valid;
+	}
+
+	static constexpr size_t size()
+	{
+		return N;
+	}
+
+	/**
+	 * @brief Find a key using a custom comparison
+	 * @param key Key to look up
+	 * @param length Length of key
+	 * @param equals Called with candidate index, returns true if key matches
+	 * @retval int Index of key in list, -1 if not found
+	 */
+	template <typename Equals> int find(const char* key, unsigned length, Equals equals) const
+	{
+		auto h = hash(key, length);
+		uint8_t d = pgm_read_byte(&displacements[h % bucketCount]);
+		if(d == 0) {
+			return -1;
+		}
+		uint8_t slot = pgm_read_byte(&slots[getSlot(h, d)]);
+		if(slot == 0 || hashes[slot - 1] != h) {
+			return -1;
+		}
+		return equals(slot - 1) ? slot - 1 : -1;
+	}
+
+	/**
+	 * @brief Find a key
+	 * @retval int Index of key in list, -1 if not found
+	 */
+	int find(const char* key, unsigned length) const
+	{
+		return find(key, length, [&](unsigned i) {
+			return pgm_read_word(&lengths[i]) == length &&
+				   memcmp_P(key, &text[pgm_read_word(&offsets[i])], length) == 0;
+		});
+	}
+
+	int find(const Element& element) const
+	{
+		return find(element.key, element.keyLength);
+	}
+
+	/**
+	 * @brief Get a key
+	 * @retval const char* NUL-terminated key, in flash if the map is
+	 */
+	const char* operator[](unsigned index) const
+	{
+		return index < N ? &text[pgm_read_word(&offsets[index])] : nullptr;
+	}
+
+private:
+	static constexpr size_t bucketCount{(N + 1) / 2};
+
+	static constexpr size_t getTableSize()
+	{
+		size_t n{1};
+		while(n < N * 2) {
+			n <<= 1;
+		}
+		return n;
+	}
+
+	static constexpr size_t tableSize{getTableSize()};
+
+	static constexpr unsigned getSlot(uint32_t h, uint8_t displacement)
+	{
+		// Murmur3 finaliser
+		h ^= displacement * 0x9E3779B9U;
+		h ^= h >> 16;
+		h *= 0x85ebca6bU;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35U;
+		h ^= h >> 16;
+		return h & (tableSize - 1);
+	}
+
+	constexpr void addKey(unsigned index, const char* key, unsigned length)
+	{
+		offsets[index] = (index == 0) ? 0 : offsets[index - 1] + lengths[index - 1] + 1;
+		lengths[index] = length;
+		for(unsigned i = 0; i < length; ++i) {
+			text[offsets[index] + i] = key[i];
+		}
+	}
+
+	constexpr bool build()
+	{
+		uint8_t bucketSizes[bucketCount]{};
+		for(unsigned i = 0; i < N; ++i) {
+			hashes[i] = hash(&text[offsets[i]], lengths[i]);
+			++bucketSizes[hashes[i] % bucketCount];
+		}
+
+		// Place largest buckets first
+		for(unsigned size = N; size > 0; --size) {
+			for(unsigned b = 0; b < bucketCount; ++b) {
+				if(bucketSizes[b] == size && !placeBucket(b)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	constexpr bool placeBucket(unsigned bucket)
+	{
+		for(unsigned d = 1; d < 256; ++d) {
+			bool ok{true};
+			for(unsigned i = 0; ok && i < N; ++i) {
+				if(hashes[i] % bucketCount != bucket) {
+					continue;
+				}
+				auto s = getSlot(hashes[i], d);
+				if(slots[s] != 0) {
+					ok = false;
+					break;
+				}
+				// Occupy slot temporarily to detect collisions within bucket
+				slots[s] = i + 1;
+			}
+			// Release slots for this bucket
+			for(unsigned i = 0; i < N; ++i) {
+				if(hashes[i] % bucketCount == bucket && slots[getSlot(hashes[i], d)] == i + 1) {
+					slots[getSlot(hashes[i], d)] = 0;
+				}
+			}
+			if(!ok) {
+				continue;
+			}
+			for(unsigned i = 0; i < N; ++i) {
+				if(hashes[i] % bucketCount == bucket) {
+					slots[getSlot(hashes[i], d)] = i + 1;
+				}
+			}
+			displacements[bucket] = d;
+			return true;
+		}
+		return false;
+	}
+
+	char text[TextSize]{}; ///< Keys, each NUL-terminated
+	uint16_t offsets[N]{};
+	uint16_t lengths[N]{};
+	uint32_t hashes[N]{};
+	uint8_t displacements[bucketCount]{}; ///< 0 indicates empty bucket
+	uint8_t slots[tableSize]{};			  ///< Key index + 1, 0 indicates empty slot
+	bool valid{false};
+};
+
+/**
+ * @brief Create a KeyMap from a list of string literals
+ */
+template <size_t... KeySizes>
+constexpr KeyMap<sizeof...(KeySizes), (KeySizes + ...)> makeKeyMap(const char (&... keys)[KeySizes])
+{
+	return KeyMap<sizeof...(KeySizes), (KeySizes + ...)>(keys...);
+}
+
+} // namespace JSON
@@ -26,10 +26,107 @@ See more at http://blog.squix.ch and https://github.com/squix78/json-streaming-p
 #pragma once
 
 #include "Element.h"
+#include "Status.h"
 
 namespace JSON
 {
-class Listener
+/**
+ * @brief Common listener functionality, without virtual methods
+ *
+ * Listeners for use with `BasicStreamingParser` via static dispatch should inherit from this
+ * and provide these methods:
+ *
+ * 	bool startElement(const Element& element);
+ * 	bool endElement(const Element& element);
+ *
+ * `stringSegment()` may also be provided to override the default.
+ */
+class ListenerBase
+{
+public:
+	/**
+	 * @brief Called for string values which are too large for the parser buffer
+	 * @param element The string element, where `value` and `valueLength` describe only this segment
+	 * @param final true for the last segment, which is passed instead of calling `startElement()`
+	 * @retval bool Return true to continue parsing.
+	 * If false is returned for the first segment (the default) the parser fails with `Status::BufferFull`,
+	 * otherwise `Status::Cancelled`.
+	 * @note Segments are split on buffer boundaries so may divide multi-byte UTF-8 sequences
+	 */
+	bool stringSegment(const Element& element, bool final)
+	{
+		(void)element;
+		(void)final;
+		return false;
+	}
+
+	/**
+	 * @brief Called in multi-document mode when an error is encountered
+	 * @param status The error
+	 * @retval bool Return true to discard the remainder of the line and continue with the next record,
+	 * or false (the default) to stop parsing and return the error.
+	 * @note Any elements already passed to the listener for the failed record remain valid,
+	 * but `endElement()` is not called for open objects or arrays.
+	 */
+	bool documentError(Status status)
+	{
+		(void)status;
+		return false;
+	}
+
+	/**
+	 * @brief Skip content of the current Object or Array
+	 *
+	 * Call from within `startElement()`. The parser moves directly to the matching closing bracket
+	 * without tokenising or buffering the content, and without calling the listener.
+	 * `endElement()` is not called for a skipped element.
+	 */
+	void skipElement()
+	{
+		skipRequested = true;
+	}
+
+	/**
+	 * @brief Used by parser to check for, and clear, a skip request
+	 */
+	bool checkSkip()
+	{
+		bool res = skipRequested;
+		skipRequested = false;
+		return res;
+	}
+
+	/**
+	 * @brief Stop parsing once the current character has been processed
+	 *
+	 * May be called from any listener method to apply backpressure.
+	 * `parse()` returns `Status::Paused` and reports the number of characters consumed,
+	 * so the caller can resume later from the following character.
+	 */
+	void pause()
+	{
+		pauseRequested = true;
+	}
+
+	/**
+	 * @brief Used by parser to check for, and clear, a pause request
+	 */
+	bool checkPause()
+	{
+		bool res = pauseRequested;
+		pauseRequested = false;
+		return res;
+	}
+
+private:
+	bool skipRequested{false};
+	bool pauseRequested{false};
+};
+
+/**
+ * @brief Listener interface using virtual methods
+ */
+class Listener : public ListenerBase
 {
 public:
 	virtual ~Listener()
@@ -39,6 +136,62 @@ public:
 	virtual bool startElement(const Element& element) = 0;
 
 	virtual bool endElement(const Element& element) = 0;
+
+	/**
+	 * @brief Called for string values which are too large for the parser buffer
+	 * @see `ListenerBase::stringSegment()`
+	 */
+	virtual bool stringSegment(const Element& element, bool final)
+	{
+		return ListenerBase::stringSegment(element, final);
+	}
+
+	/**
+	 * @brief Called in multi-document mode when an error is encountered
+	 * @see `ListenerBase::documentError()`
+	 */
+	virtual bool documentError(Status status)
+	{
+		return ListenerBase::documentError(status);
+	}
 };
 
+/**
+ * @brief Listener which invokes a pair of callables, such as lambdas
+ *
+ * Example::
+ *
+ * 	auto listener = JSON::makeListener(
+ * 		[](const JSON::Element& element) { ...; return true; },
+ * 		[](const JSON::Element& element) { return true; });
+ * 	JSON::StaticStreamingParser<128, decltype(listener)> parser(&listener);
+ */
+template <typename StartElement, typename EndElement> class CallbackListener : public ListenerBase
+{
+public:
+	CallbackListener(StartElement onStart, EndElement onEnd) : onStart(onStart), onEnd(onEnd)
+	{
+	}
+
+	bool startElement(const Element& element)
+	{
+		return onStart(element);
+	}
+
+	bool endElement(const Element& element)
+	{
+		return onEnd(element);
+	}
+
+private:
+	StartElement onStart;
+	EndElement onEnd;
+};
+
+template <typename StartElement, typename EndElement>
+CallbackListener<StartElement, EndElement> makeListener(StartElement onStart, EndElement onEnd)
+{
+	return CallbackListener<StartElement, EndElement>(onStart, onEnd);
+}
+
 } // namespace JSON
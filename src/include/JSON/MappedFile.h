@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Status.h"
+#include <cstddef>
+#include <algorithm>
+
+#if defined(ARCH_HOST) && !defined(__WIN32)
+
+namespace JSON
+{
+/**
+ * @brief Read-only memory-mapped file, for parsing large documents on the host without copying
+ *
+ * Example::
+ *
+ * 	JSON::MappedFile file("export.json");
+ * 	if(file) {
+ * 		auto status = file.parse(parser);
+ * 	}
+ *
+ * @note Available for Host builds on POSIX systems only
+ */
+class MappedFile
+{
+public:
+	/**
+	 * @brief Map a file
+	 * @param filename Path to file on host filesystem
+	 * @note Check success using `operator bool()`
+	 */
+	MappedFile(const char* filename);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	explicit operator bool() const
+	{
+		return mapping != nullptr;
+	}
+
+	const char* data() const
+	{
+		return mapping;
+	}
+
+	size_t size() const
+	{
+		return length;
+	}
+
+	/**
+	 * @brief Parse the file content
+	 * @param parser Parser to use, content is passed as a series of large blocks
+	 * @retval Status As for `BasicStreamingParser::parse(Stream&)`
+	 */
+	template <class Parser> Status parse(Parser& parser) const
+	{
+		if(mapping == nullptr) {
+			return Status::NoMoreData;
+		}
+		// Parser takes unsigned block lengths
+		constexpr size_t maxBlockSize{1U << 30};
+		for(size_t pos = 0; pos < length;) {
+			auto blockSize = std::min(length - pos, maxBlockSize);
+			auto status = parser.parse(mapping + pos, blockSize);
+			if(status != Status::Ok) {
+				return status;
+			}
+			pos += blockSize;
+		}
+		return Status::NoMoreData;
+	}
+
+private:
+	const char* mapping{nullptr};
+	size_t length{0};
+};
+
+} // namespace JSON
+
+#endif
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "StreamingParser.h"
+
+#ifdef ARCH_HOST
+
+#include <functional>
+#include <memory>
+
+namespace JSON
+{
+/**
+ * @brief Parses newline-delimited JSON (NDJSON) from memory using a pool of worker threads
+ *
+ * The input is divided into slices on line boundaries. Each slice is parsed by a worker thread
+ * using its own parser (in multi-document mode) and its own listener.
+ *
+ * Example::
+ *
+ * 	JSON::NdjsonReader reader(
+ * 		[](const JSON::NdjsonReader::Slice& slice) { return std::unique_ptr<JSON::Listener>(new MyListener); },
+ * 		[&](JSON::NdjsonReader::Slice& slice) {
+ * 			auto& listener = static_cast<MyListener&>(*slice.listener);
+ * 			total += listener.count;
+ * 			return true;
+ * 		});
+ * 	JSON::MappedFile file("events.ndjson");
+ * 	auto status = reader.parse(file.data(), file.size());
+ *
+ * @note Available for Host builds only
+ */
+class NdjsonReader
+{
+public:
+	/**
+	 * @brief Describes a portion of the input
+	 */
+	struct Slice {
+		unsigned index;				  ///< Position of slice in input, starting at 0
+		size_t offset;				  ///< Position of first character in input
+		size_t length;				  ///< Number of characters
+		unsigned documentCount;		  ///< Records parsed, including any discarded following an error
+		Status status;				  ///< Result, see `parse()`
+		std::unique_ptr<Listener> listener; ///< Listener which received elements for this slice
+	};
+
+	/**
+	 * @brief Called from a worker thread to create the listener for a slice
+	 * @note Must be thread-safe
+	 */
+	using CreateListener = std::function<std::unique_ptr<Listener>(const Slice& slice)>;
+
+	/**
+	 * @brief Called from the thread which invoked `parse()` once a slice has been parsed
+	 * @retval bool Return false to stop parsing, in which case `parse()` returns `Status::Cancelled`
+	 * @note The listener is destroyed on return, unless moved out of the slice
+	 */
+	using SliceComplete = std::function<bool(Slice& slice)>;
+
+	NdjsonReader(CreateListener createListener, SliceComplete sliceComplete)
+		: createListener(createListener), sliceComplete(sliceComplete)
+	{
+	}
+
+	/**
+	 * @brief Set number of worker threads
+	 * @param count Use 0 for one per available CPU (the default)
+	 */
+	void setThreadCount(unsigned count)
+	{
+		threadCount = count;
+	}
+
+	/**
+	 * @brief Set approximate size of each slice, which is extended to the next newline
+	 */
+	void setSliceSize(size_t size)
+	{
+		sliceSize = size;
+	}
+
+	/**
+	 * @brief Set parser buffer size, which must accommodate the largest key or value
+	 */
+	void setBufferSize(uint16_t size)
+	{
+		bufferSize = size;
+	}
+
+	/**
+	 * @brief Determine order in which completed slices are passed to the `SliceComplete` callback
+	 * @param ordered true (the default) for input order, false for order of completion
+	 */
+	void setOrdered(bool ordered)
+	{
+		this->ordered = ordered;
+	}
+
+	/**
+	 * @brief Parse content
+	 * @param data Content, which must remain valid until this call returns
+	 * @param length Number of characters
+	 * @retval Status For the whole input and for each slice:
+	 * `Status::EndOfDocument` if all records were completed, `Status::NoMoreData` if the last record was
+	 * incomplete, or the error which stopped parsing. The status of the first failing slice is returned.
+	 *
+	 * Element offsets are relative to the start of the input.
+	 * Workers run at most twice the number of threads slices ahead of delivery,
+	 * so a slow slice does not cause the results of all those following to be held in memory.
+	 */
+	Status parse(const char* data, size_t length);
+
+private:
+	void parseSlice(const char* data, Slice& slice);
+
+	CreateListener createListener;
+	SliceComplete sliceComplete;
+	size_t sliceSize{1024 * 1024};
+	unsigned threadCount{0};
+	uint16_t bufferSize{1024};
+	bool ordered{true};
+};
+
+} // namespace JSON
+
+#endif
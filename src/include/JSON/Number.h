@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Set to 1 to decode numbers as scaled decimal integers, without using floating point
+ */
+#ifndef JSON_FIXED_POINT
+#define JSON_FIXED_POINT 0
+#endif
+
+/**
+ * @brief Set to 1 to use the Eisel-Lemire algorithm for numbers which cannot be converted exactly using a
+ * single floating-point operation. Otherwise `strtod()` is used. Requires a 10KB table.
+ */
+#ifndef JSON_EISEL_LEMIRE
+#define JSON_EISEL_LEMIRE 0
+#endif
+
+namespace JSON
+{
+/**
+ * @brief Decimal value accumulated whilst lexing a number: mantissa * 10^exponent
+ */
+struct Decimal {
+	uint64_t mantissa{0};
+	int16_t exponent{0};
+	bool isNegative{false};
+	bool isTruncated{false}; ///< Digits were discarded because mantissa is limited to 19 digits
+
+	/**
+	 * @brief Get value as an integer with a fixed number of fractional digits
+	 * @param digits Number of fractional digits required
+	 * @param round Set to round half away from zero, otherwise truncate towards zero
+	 * @retval int64_t Value scaled by 10^digits, so 12.345 with 2 digits gives 1235 if rounded, or 1234 if not.
+	 * Saturates if value is out of range.
+	 */
+	int64_t scaled(unsigned digits, bool round = true) const;
+
+	/**
+	 * @brief Get value as a double
+	 * @note Uses floating point so should be avoided on targets without an FPU
+	 */
+	double toDouble() const;
+};
+
+/**
+ * @brief Numeric value decoded by the parser
+ */
+struct Number {
+#if JSON_FIXED_POINT
+	Decimal decimal;
+#else
+	union {
+		int64_t integer{0};
+		double real;
+	};
+#endif
+	bool isInteger{true}; ///< Value had no fraction or exponent and fits into `integer`
+
+	/**
+	 * @brief Get value with conversion
+	 * @note Conversion to an integer type truncates any fraction, and saturates if the value is out of range
+	 */
+	template <typename T> T as() const
+	{
+#if JSON_FIXED_POINT
+		if constexpr(std::is_floating_point<T>::value) {
+			return T(decimal.toDouble());
+		} else {
+			// Truncate, as for conversion from double
+			return clamp<T>(decimal.scaled(0, false));
+		}
+#else
+		if constexpr(std::is_floating_point<T>::value) {
+			return isInteger ? T(integer) : T(real);
+		} else {
+			return isInteger ? clamp<T>(integer) : clamp<T>(real);
+		}
+#endif
+	}
+
+	/**
+	 * @brief Convert to an integer type, saturating at its limits
+	 */
+	template <typename T, typename V> static T clamp(V value)
+	{
+		using Limits = std::numeric_limits<T>;
+		if constexpr(std::is_floating_point<V>::value) {
+			if(value != value) {
+				// NaN
+				return 0;
+			}
+			if(value <= V(Limits::min())) {
+				return Limits::min();
+			}
+			if(value >= V(Limits::max())) {
+				return Limits::max();
+			}
+		} else {
+			if(value < 0 && (!Limits::is_signed || value < int64_t(Limits::min()))) {
+				return Limits::min();
+			}
+			if(value > 0 && uint64_t(value) > uint64_t(Limits::max())) {
+				return Limits::max();
+			}
+		}
+		return T(value);
+	}
+
+	bool isZero() const
+	{
+#if JSON_FIXED_POINT
+		return decimal.mantissa == 0;
+#else
+		return isInteger ? integer == 0 : real == 0;
+#endif
+	}
+
+	/**
+	 * @brief Convert a lexed decimal value
+	 * @param decimal The value to convert
+	 * @param isInteger true if the number text contained no decimal point or exponent
+	 * @param text NUL-terminated number text, used if value cannot be converted exactly from `decimal`
+	 */
+	static Number fromDecimal(const Decimal& decimal, bool isInteger, const char* text);
+};
+
+} // namespace JSON
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Number.h"
+#include "Scan.h"
+
+namespace JSON
+{
+/**
+ * @brief Tracks which parts of a number have been seen so far, and the value
+ */
+struct NumberState {
+	Decimal value;
+	int32_t scale;		 ///< Adjustment to exponent for fraction digits and discarded integer digits
+	uint16_t exponent;	 ///< Value of explicit exponent
+	uint8_t digitCount;  ///< Significant digits in mantissa
+	uint8_t hasPoint : 1;
+	uint8_t hasExponent : 1;
+	uint8_t exponentIsNegative : 1;
+
+	/**
+	 * @brief Accumulate a run of decimal digits
+	 */
+	void addDigits(const char* digits, unsigned count)
+	{
+		if(hasExponent) {
+			while(count--) {
+				// Saturate: anything larger overflows a double anyway, and another digit would overflow exponent
+				if(exponent < 6553) {
+					exponent = (exponent * 10) + (*digits - '0');
+				}
+				++digits;
+			}
+			return;
+		}
+
+		constexpr uint8_t maxDigits{19};
+
+		// Leading zeroes are not significant
+		while(count != 0 && value.mantissa == 0 && *digits == '0') {
+			if(hasPoint) {
+				--scale;
+			}
+			++digits;
+			--count;
+		}
+
+		while(count >= 8 && digitCount + 8 <= maxDigits) {
+			value.mantissa = (value.mantissa * 100000000) + Scan::parseEightDigits(digits);
+			digitCount += 8;
+			if(hasPoint) {
+				scale -= 8;
+			}
+			digits += 8;
+			count -= 8;
+		}
+
+		for(; count != 0; --count, ++digits) {
+			if(digitCount < maxDigits) {
+				value.mantissa = (value.mantissa * 10) + (*digits - '0');
+				++digitCount;
+				if(hasPoint) {
+					--scale;
+				}
+				continue;
+			}
+			if(*digits != '0') {
+				value.isTruncated = true;
+			}
+			if(!hasPoint) {
+				++scale;
+			}
+		}
+	}
+
+	/**
+	 * @brief Obtain the value once all characters have been seen
+	 * @param text NUL-terminated number text
+	 */
+	Number getNumber(const char* text)
+	{
+		int32_t total = scale + (exponentIsNegative ? -exponent : exponent);
+		if(total < INT16_MIN) {
+			total = INT16_MIN;
+		} else if(total > INT16_MAX) {
+			total = INT16_MAX;
+		}
+		value.exponent = total;
+		bool isInteger = !hasPoint && !hasExponent;
+		return Number::fromDecimal(value, isInteger, text);
+	}
+};
+
+} // namespace JSON
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Element.h"
+#include <limits>
+
+namespace JSON
+{
+/**
+ * @brief Compiled path expression identifying elements within a document
+ *
+ * Two syntaxes are supported:
+ *
+ * - JSONPath subset: `$`, `$.items[*].id`, `$.meta.total`, `$['key with spaces'][2]`, `$.list.*`
+ * - JSON Pointer (RFC 6901): `/meta/total`, `/items/0/id`, with `~0` and `~1` escapes
+ *
+ * Parsers count array items using their `Counter` type, which saturates at its maximum value
+ * (255 for the default `uint8_t`), so larger indices cannot be distinguished.
+ * A JSONPath index beyond the limit given to the constructor therefore fails to compile.
+ * A JSON Pointer reference token beyond the limit is treated as an object key.
+ *
+ * For example, with a parser using a `uint32_t` counter::
+ *
+ * 	JSON::Path path("$.items[1000]", false, JSON::Path::indexLimit<uint32_t>());
+ *
+ *
+ * The expression string is referenced, not copied, so must remain valid for the lifetime of the Path.
+ */
+class Path
+{
+public:
+	/**
+	 * @brief Limit on number of steps (nesting levels) in an expression
+	 */
+	static constexpr uint8_t maxSteps{10};
+
+	/**
+	 * @brief Get the largest array index which a parser can distinguish
+	 * @tparam Counter The parser's `Counter` template parameter
+	 */
+	template <typename Counter> static constexpr uint32_t indexLimit()
+	{
+		return std::numeric_limits<Counter>::max() - 1;
+	}
+
+	/**
+	 * @brief Limit on array indices suitable for parsers with the default counter
+	 */
+	static constexpr uint32_t defaultMaxIndex{std::numeric_limits<uint8_t>::max() - 1};
+
+	/**
+	 * @brief Compile a path expression
+	 * @param expr JSONPath or JSON Pointer expression
+	 * @param oneShot Set if only the first matching element is required
+	 * @param maxIndex Largest array index the parser can distinguish, see `indexLimit()`
+	 */
+	Path(const char* expr, bool oneShot = false, uint32_t maxIndex = defaultMaxIndex);
+
+	/**
+	 * @brief Determine if expression compiled successfully
+	 */
+	explicit operator bool() const
+	{
+		return valid;
+	}
+
+	/**
+	 * @brief Get number of steps. 0 indicates the root element.
+	 */
+	uint8_t getDepth() const
+	{
+		return stepCount;
+	}
+
+	bool isOneShot() const
+	{
+		return oneShot;
+	}
+
+	/**
+	 * @brief Check element against one step of the path
+	 * @param step Index of step to check, corresponds to `element.level - 1`
+	 * @param element Element to check
+	 * @retval bool true if element satisfies the step
+	 */
+	bool matchStep(uint8_t step, const Element& element) const;
+
+	/**
+	 * @brief Check whether element is identified by this path
+	 * @param element The element
+	 * @param ancestorsMatch Set if all ancestors of element have matched their steps
+	 */
+	bool match(const Element& element, bool ancestorsMatch = true) const
+	{
+		if(!ancestorsMatch || element.level != stepCount) {
+			return false;
+		}
+		return element.level == 0 || matchStep(element.level - 1, element);
+	}
+
+private:
+	struct Step {
+		enum class Type : uint8_t {
+			Key,		///< Object member with key
+			Index,		///< Array item with index
+			KeyOrIndex, ///< JSON Pointer reference token which can be either
+			Any,		///< Wildcard
+		};
+		Type type;
+		uint8_t escaped; ///< JSON Pointer key contains escapes
+		uint16_t keyOffset;
+		uint16_t keyLength;
+		uint32_t index;
+	};
+
+	bool compilePath(uint32_t maxIndex);
+	bool compilePointer(uint32_t maxIndex);
+	bool addStep(Step::Type type, const char* key, unsigned keyLength, uint32_t maxIndex);
+	bool keyMatches(const Step& step, const Element& element) const;
+
+	const char* expr;
+	Step steps[maxSteps];
+	uint8_t stepCount{0};
+	bool oneShot;
+	bool valid;
+};
+
+} // namespace JSON
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Listener.h"
+#include "StreamingWriter.h"
+
+namespace JSON
+{
+/**
+ * @brief Listener which writes parsed elements back out as JSON
+ *
+ * Numbers are written exactly as they appear in the input. Strings are re-escaped as required,
+ * and strings passed by the parser in segments are written without further buffering.
+ * Output is flushed at the end of each document.
+ *
+ * Parsing is cancelled if the writer fails: use `StreamingWriter::getStatus()` to find out why.
+ */
+class Printer : public Listener
+{
+public:
+	Printer(StreamingWriter& writer) : writer(writer)
+	{
+	}
+
+	bool startElement(const Element& element) override;
+
+	bool endElement(const Element& element) override;
+
+	bool stringSegment(const Element& element, bool final) override;
+
+private:
+	bool writeKey(const Element& element);
+	bool endDocument();
+
+	StreamingWriter& writer;
+	bool segmented{false};
+};
+
+/**
+ * @brief Listener which writes parsed documents in compact form, without whitespace
+ *
+ * Example::
+ *
+ * 	JSON::Minifier<> minifier(output);
+ * 	JSON::StaticStreamingParser<128> parser(&minifier);
+ * 	auto status = parser.parse(input);
+ *
+ * @tparam BUFSIZE Size of output buffer
+ */
+template <uint16_t BUFSIZE = 64> class Minifier : public Printer
+{
+public:
+	Minifier(Print& output) : Printer(writer), writer(output)
+	{
+	}
+
+	StreamingWriter& getWriter()
+	{
+		return writer;
+	}
+
+private:
+	StaticStreamingWriter<BUFSIZE> writer;
+};
+
+/**
+ * @brief Listener which writes parsed documents with each element on a separate, indented line
+ * @tparam BUFSIZE Size of output buffer
+ */
+template <uint16_t BUFSIZE = 64> class PrettyPrinter : public Printer
+{
+public:
+	/**
+	 * @param output Where to write
+	 * @param indent Number of spaces for each nesting level
+	 */
+	PrettyPrinter(Print& output, uint8_t indent = 2) : Printer(writer), writer(output)
+	{
+		writer.setIndent(indent);
+	}
+
+	StreamingWriter& getWriter()
+	{
+		return writer;
+	}
+
+private:
+	StaticStreamingWriter<BUFSIZE> writer;
+};
+
+} // namespace JSON
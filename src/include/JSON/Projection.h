@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Printer.h"
+#include "Path.h"
+
+namespace JSON
+{
+/**
+ * @brief Listener which writes a subset of the document, in compact form, to a StreamingWriter
+ *
+ * Elements matching any of the `include` paths are written together with all of their descendants,
+ * except those matching an `exclude` path. If no include paths are given then the whole document is included.
+ *
+ * The result is a valid document with the original nesting. Ancestors of included elements are written
+ * only when the first included descendant is found, so containers holding nothing of interest are omitted.
+ * The root container is always written. Array items are renumbered as a result of the projection.
+ *
+ * Memory usage is fixed: objects or arrays which cannot contain a match are skipped by the parser,
+ * and the keys of pending ancestors are held in a small internal buffer.
+ * Parsing is cancelled if these keys exceed `keyBufferSize`, or if the writer fails.
+ *
+ * Example::
+ *
+ * 	JSON::Path include[]{{"$.device.id"}, {"$.readings"}};
+ * 	JSON::Path exclude[]{{"$.readings[*].raw"}};
+ * 	JSON::StaticStreamingWriter<64> writer(output);
+ * 	JSON::Projection projection(writer, include, ARRAY_SIZE(include), exclude, ARRAY_SIZE(exclude));
+ * 	JSON::StaticStreamingParser<128> parser(&projection);
+ * 	auto status = parser.parse(input);
+ */
+class Projection : public Listener
+{
+public:
+	/**
+	 * @brief Maximum number of paths in each set
+	 */
+	static constexpr uint8_t maxPaths{32};
+
+	/**
+	 * @brief Space for keys of ancestors which have not yet been written
+	 */
+	static constexpr uint16_t keyBufferSize{128};
+
+	/**
+	 * @brief Constructor
+	 * @param writer Output
+	 * @param include Paths to elements which should be written. Invalid paths are ignored.
+	 * @param includeCount Number of include paths, 0 to include the entire document
+	 * @param exclude Paths to elements which should be omitted
+	 * @param excludeCount Number of exclude paths
+	 */
+	Projection(StreamingWriter& writer, const Path* include, uint8_t includeCount, const Path* exclude = nullptr,
+			   uint8_t excludeCount = 0);
+
+	/* Listener methods */
+
+	bool startElement(const Element& element) override;
+
+	bool endElement(const Element& element) override;
+
+	bool stringSegment(const Element& element, bool final) override;
+
+private:
+	struct PathSet {
+		const Path* paths;
+		uint8_t count;
+		uint32_t mask;						///< Valid paths
+		uint32_t live[Path::maxSteps + 1]; ///< Paths whose ancestors match, by level
+
+		PathSet(const Path* paths, uint8_t count);
+		uint32_t match(const Element& element, uint32_t& partial) const;
+	};
+
+	struct Ancestor {
+		uint16_t keyOffset;
+		uint16_t keyLength;
+		bool hasKey;
+		bool isObject;
+	};
+
+	enum class Action : uint8_t {
+		Discard,
+		Skip,
+		Write,
+	};
+
+	Action select(const Element& element);
+	bool saveAncestor(const Element& element);
+	bool openAncestors(uint16_t level);
+
+	StreamingWriter& writer;
+	Printer printer;
+	PathSet include;
+	PathSet exclude;
+	Ancestor ancestors[Path::maxSteps];
+	char keys[keyBufferSize];
+	uint16_t includeLevel{0};
+	bool inInclude{false};
+	bool inString{false};	///< Receiving string segments
+	bool writeString{false}; ///< String segments are being written
+};
+
+} // namespace JSON
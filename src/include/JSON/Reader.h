@@ -0,0 +1,183 @@
+#pragma once
+
+#include "StreamingParser.h"
+#include "Generator.h"
+
+namespace JSON
+{
+/**
+ * @brief Pull-style interface to the streaming parser
+ *
+ * Instead of supplying a listener, the caller asks for each element in turn::
+ *
+ * 	char buffer[128];
+ * 	JSON::Reader reader(buffer, sizeof(buffer));
+ * 	reader.feed(data, length);
+ * 	while(reader.next() == JSON::Status::Ok) {
+ * 		auto& token = reader.getToken();
+ * 		if(token.event == JSON::Reader::Event::Start && token.element.level == 1) {
+ * 			...
+ * 		}
+ * 	}
+ *
+ * When `next()` returns `Status::NoMoreData` the current input has been consumed.
+ * Call `feed()` with the following block of input to continue.
+ *
+ * Input is consumed only as far as required to produce the next token, so the caller may
+ * call `skip()` after receiving an object or array to pass over its content without tokenising it.
+ *
+ * @note Strings must fit into the buffer: segmented strings are not supported.
+ */
+class Reader
+{
+public:
+	enum class Event : uint8_t {
+		Start, ///< Corresponds to `Listener::startElement()`
+		End,   ///< Corresponds to `Listener::endElement()`
+	};
+
+	struct Token {
+		Event event;
+		Element element;
+	};
+
+	Reader(char* buffer, uint16_t bufsize, void* param = nullptr) : parser(buffer, bufsize, &queue, param)
+	{
+	}
+
+	/**
+	 * @brief Supply the next block of input
+	 * @note Content must remain valid until `next()` returns `Status::NoMoreData`
+	 */
+	void feed(const char* data, size_t length)
+	{
+		input = data;
+		inputEnd = data + length;
+	}
+
+	/**
+	 * @brief Advance to the next token
+	 * @retval Status
+	 * 	- `Status::Ok` if a token is available via `getToken()`
+	 * 	- `Status::NoMoreData` if the input has been consumed: call `feed()` then try again
+	 * 	- `Status::EndOfDocument` if the document is complete
+	 * 	- otherwise the parsing error
+	 */
+	Status next();
+
+	/**
+	 * @brief Get the current token
+	 * @note Valid only after `next()` returns `Status::Ok`, and only until it is next called
+	 */
+	const Token& getToken() const
+	{
+		return queue.tokens[current];
+	}
+
+	/**
+	 * @brief Skip content of the object or array just returned by `next()`
+	 *
+	 * No further tokens are returned for its content, nor its `Event::End`.
+	 *
+	 * @retval bool false if the current token is not the start of an object or array
+	 */
+	bool skip();
+
+	/**
+	 * @brief Get result of parsing
+	 * @retval Status `Status::NoMoreData` whilst the document is incomplete, otherwise as for `next()`
+	 */
+	Status getStatus() const
+	{
+		return (status == Status::Ok) ? Status::NoMoreData : status;
+	}
+
+	/**
+	 * @brief Get position in input of the next character to be parsed
+	 */
+	size_t getOffset() const
+	{
+		return parser.getOffset();
+	}
+
+	/**
+	 * @brief Prepare to read a new document
+	 */
+	void reset();
+
+#ifdef __cpp_impl_coroutine
+	/**
+	 * @brief Generate all tokens from a block of input
+	 *
+	 * Iteration ends when the input is consumed, the document is complete or an error occurs.
+	 * Use `getStatus()` to determine which.
+	 */
+	Generator<const Token&> tokens(const char* data, size_t length);
+
+	/**
+	 * @brief Generate all tokens from a stream
+	 */
+	Generator<const Token&> tokens(Stream& stream);
+#endif
+
+private:
+	/**
+	 * @brief Listener which holds tokens produced by the last character parsed
+	 *
+	 * The parser is paused after each token. One character can complete at most two tokens,
+	 * such as a number terminated by a closing bracket.
+	 */
+	class Queue : public ListenerBase
+	{
+	public:
+		bool startElement(const Element& element)
+		{
+			return add(Event::Start, element);
+		}
+
+		bool endElement(const Element& element)
+		{
+			return add(Event::End, element);
+		}
+
+		static constexpr uint8_t capacity{2};
+		Token tokens[capacity];
+		uint8_t count{0};
+
+	private:
+		bool add(Event event, const Element& element)
+		{
+			if(count == capacity) {
+				return false;
+			}
+			tokens[count++] = {event, element};
+			pause();
+			return true;
+		}
+	};
+
+	Queue queue;
+	BasicStreamingParser<Queue> parser;
+	const char* input{nullptr};
+	const char* inputEnd{nullptr};
+	Status status{Status::Ok};
+	uint8_t current{0}; ///< Index of current token in queue
+};
+
+/**
+ * @brief Reader with internal buffer
+ */
+template <uint16_t BUFSIZE> class StaticReader : public Reader
+{
+public:
+	static_assert(BUFSIZE >= 32, "Buffer too small");
+
+	StaticReader(void* param = nullptr) : Reader(buffer, BUFSIZE, param)
+	{
+	}
+
+private:
+	char buffer[BUFSIZE];
+};
+
+} // namespace JSON
@@ -0,0 +1,241 @@
+/**
+ * Scan.h - Block scanning helpers used by the parser
+ *
+ * Locate the next 'interesting' character in a block of input without
+ * examining each byte individually. Uses SSE2 where available, otherwise
+ * portable word-at-a-time (SWAR) operations which suit Xtensa, RISC-V and ARM.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace JSON
+{
+namespace Scan
+{
+using Word = uintptr_t;
+
+constexpr Word repeat(uint8_t c)
+{
+	return (Word(~Word(0)) / 0xff) * c;
+}
+
+constexpr Word highBits{repeat(0x80)};
+
+/**
+ * @brief Mark zero bytes
+ * @retval Word High bit set for each byte in `x` which is zero
+ */
+inline Word zeroBytes(Word x)
+{
+	return ~(((x & ~highBits) + ~highBits) | x) & highBits;
+}
+
+/**
+ * @brief Mark bytes equal to `c`
+ */
+inline Word equalBytes(Word x, uint8_t c)
+{
+	return zeroBytes(x ^ repeat(c));
+}
+
+/**
+ * @brief Mark bytes less than `n`
+ * @note Requires n <= 0x80
+ */
+inline Word lessBytes(Word x, uint8_t n)
+{
+	return ~((x & ~highBits) + repeat(0x80 - n)) & ~x & highBits;
+}
+
+/**
+ * @brief Get position of first marked byte in a word
+ * @param mask Must be non-zero
+ */
+inline unsigned firstByte(Word mask)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	return (sizeof(Word) == 8 ? __builtin_ctzll(mask) : __builtin_ctz(mask)) / 8;
+#else
+	return (sizeof(Word) == 8 ? __builtin_clzll(mask) : __builtin_clz(mask)) / 8;
+#endif
+}
+
+/**
+ * @brief Find first byte for which `match` is true
+ * @param ptr Start of block
+ * @param end End of block
+ * @param matchWord Returns mask of matching bytes in a word, as for `zeroBytes()`
+ * @param matchByte Returns true if a single byte matches
+ * @retval const char* Matching position, or `end` if not found
+ */
+template <typename MatchWord, typename MatchByte>
+const char* find(const char* ptr, const char* end, MatchWord matchWord, MatchByte matchByte)
+{
+	// Align to word boundary
+	while(ptr < end && (uintptr_t(ptr) % sizeof(Word)) != 0) {
+		if(matchByte(uint8_t(*ptr))) {
+			return ptr;
+		}
+		++ptr;
+	}
+
+	while(end - ptr >= std::ptrdiff_t(sizeof(Word))) {
+		Word w;
+		memcpy(&w, ptr, sizeof(w));
+		auto mask = matchWord(w);
+		if(mask != 0) {
+			return ptr + firstByte(mask);
+		}
+		ptr += sizeof(Word);
+	}
+
+	while(ptr < end) {
+		if(matchByte(uint8_t(*ptr))) {
+			return ptr;
+		}
+		++ptr;
+	}
+
+	return end;
+}
+
+/**
+ * @brief Find a character which ends a run of plain string content
+ *
+ * Stops at quote, backslash, control characters and DEL.
+ * Characters >= 0x80 (UTF-8 sequences) are treated as plain content.
+ */
+inline const char* findStringSpecial(const char* ptr, const char* end)
+{
+#ifdef __SSE2__
+	const auto quote = _mm_set1_epi8('"');
+	const auto backslash = _mm_set1_epi8('\\');
+	const auto del = _mm_set1_epi8(0x7f);
+	const auto space = _mm_set1_epi8(0x20);
+	const auto minusOne = _mm_set1_epi8(-1);
+	while(end - ptr >= 16) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		auto ctrl = _mm_and_si128(_mm_cmplt_epi8(v, space), _mm_cmpgt_epi8(v, minusOne));
+		auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+							  _mm_or_si128(_mm_cmpeq_epi8(v, del), ctrl));
+		unsigned mask = _mm_movemask_epi8(m);
+		if(mask != 0) {
+			return ptr + __builtin_ctz(mask);
+		}
+		ptr += 16;
+	}
+#endif
+
+	return find(
+		ptr, end,
+		[](Word w) { return equalBytes(w, '"') | equalBytes(w, '\\') | equalBytes(w, 0x7f) | lessBytes(w, 0x20); },
+		[](uint8_t c) { return c == '"' || c == '\\' || c == 0x7f || c < 0x20; });
+}
+
+/**
+ * @brief Skip JSON whitespace
+ * @retval const char* First non-whitespace character, or `end` if there is none
+ */
+inline const char* skipWhitespace(const char* ptr, const char* end)
+{
+#ifdef __SSE2__
+	const auto space = _mm_set1_epi8(' ');
+	const auto tab = _mm_set1_epi8('\t');
+	const auto newline = _mm_set1_epi8('\n');
+	const auto ret = _mm_set1_epi8('\r');
+	while(end - ptr >= 16) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+							  _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, ret)));
+		unsigned mask = ~_mm_movemask_epi8(m) & 0xffff;
+		if(mask != 0) {
+			return ptr + __builtin_ctz(mask);
+		}
+		ptr += 16;
+	}
+#endif
+
+	return find(
+		ptr, end,
+		[](Word w) {
+			return ~(equalBytes(w, ' ') | equalBytes(w, '\t') | equalBytes(w, '\n') | equalBytes(w, '\r')) & highBits;
+		},
+		[](uint8_t c) { return c != ' ' && c != '\t' && c != '\n' && c != '\r'; });
+}
+
+/**
+ * @brief Find a character which affects nesting when skipping content
+ *
+ * Stops at quote, backslash and brackets.
+ */
+inline const char* findSkipSpecial(const char* ptr, const char* end)
+{
+#ifdef __SSE2__
+	// Brackets differ from braces only by bit 5, so fold them together
+	const auto quote = _mm_set1_epi8('"');
+	const auto backslash = _mm_set1_epi8('\\');
+	const auto caseBit = _mm_set1_epi8(0x20);
+	const auto open = _mm_set1_epi8('{');
+	const auto close = _mm_set1_epi8('}');
+	while(end - ptr >= 16) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		auto folded = _mm_or_si128(v, caseBit);
+		auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+							  _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)));
+		unsigned mask = _mm_movemask_epi8(m);
+		if(mask != 0) {
+			return ptr + __builtin_ctz(mask);
+		}
+		ptr += 16;
+	}
+#endif
+
+	return find(
+		ptr, end,
+		[](Word w) {
+			auto folded = w | repeat(0x20);
+			return equalBytes(w, '"') | equalBytes(w, '\\') | equalBytes(folded, '{') | equalBytes(folded, '}');
+		},
+		[](uint8_t c) { return c == '"' || c == '\\' || (c | 0x20) == '{' || (c | 0x20) == '}'; });
+}
+
+/**
+ * @brief Find first character which is not a decimal digit
+ */
+inline const char* findNonDigit(const char* ptr, const char* end)
+{
+	return find(
+		ptr, end, [](Word w) { return ~lessBytes(w ^ repeat('0'), 10) & highBits; },
+		[](uint8_t c) { return c < '0' || c > '9'; });
+}
+
+/**
+ * @brief Convert 8 ASCII decimal digits into an integer value
+ */
+inline uint32_t parseEightDigits(const char* digits)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	uint64_t val;
+	memcpy(&val, digits, sizeof(val));
+	val = ((val & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+	val = ((val & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+	return uint32_t(((val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+#else
+	uint32_t val{0};
+	for(unsigned i = 0; i < 8; ++i) {
+		val = (val * 10) + (digits[i] - '0');
+	}
+	return val;
+#endif
+}
+
+} // namespace Scan
+} // namespace JSON
@@ -8,6 +8,7 @@
 	XX(Cancelled)                                                                                                      \
 	XX(InvalidStream)                                                                                                  \
 	XX(NoMoreData)                                                                                                     \
+	XX(Paused)                                                                                                         \
 	XX(ColonExpected)                                                                                                  \
 	XX(OpeningBraceExpected)                                                                                           \
 	XX(StringStartExpected)                                                                                            \
@@ -19,6 +20,7 @@
 	XX(HexExpected)                                                                                                    \
 	XX(UnexpectedContentAfterDocument)                                                                                 \
 	XX(UnexpectedEndOfString)                                                                                          \
+	XX(UnexpectedEndOfRecord)                                                                                          \
 	XX(NotInObject)                                                                                                    \
 	XX(NotInArray)                                                                                                     \
 	XX(UnescapedControl)                                                                                               \
@@ -31,6 +33,7 @@
 	XX(BadUnicodeEscapeChar)                                                                                           \
 	XX(BufferFull)                                                                                                     \
 	XX(StackFull)                                                                                                      \
+	XX(WriteFailed)                                                                                                    \
 	XX(InternalError)
 
 namespace JSON
@@ -32,23 +32,34 @@
 
 #include "Listener.h"
 #include "Status.h"
-#include "Stack.h"
+#include "ContainerStack.h"
+#include "NumberState.h"
 #include <Stream.h>
+#include <Data/Stream/DataSourceStream.h>
+
+#ifndef JSON_STREAM_CHUNK_SIZE
+#define JSON_STREAM_CHUNK_SIZE 64
+#endif
 
 namespace JSON
 {
 /**
  * @brief Streaming parser
- * @tparam BUFSIZE Size of buffer must be large enough to contain the longest
- * key and value strings in the content being parsed.
+ * @tparam ListenerT Type of listener to receive elements.
+ * Use `Listener` (i.e. `StreamingParser`) for virtual dispatch, or a concrete class
+ * based on `ListenerBase` to allow listener methods to be inlined into the parser.
+ * See also `CallbackListener`.
+ * @tparam nestingLimit Maximum nesting depth. Each level costs one bit plus one `Counter`.
+ * @tparam Counter Type used to count children of each object or array, see `ContainerStack`.
+ * Use `uint32_t` to obtain correct indices for large arrays.
  */
-class StreamingParser
+template <class ListenerT, unsigned nestingLimit = 20, typename Counter = uint8_t> class BasicStreamingParser
 {
 public:
 	/**
 	 * @brief Place a hard limit on nesting depth
 	 */
-	static constexpr uint8_t maxNesting{20};
+	static constexpr unsigned maxNesting{nestingLimit};
 
 	enum class State {
 		START_DOCUMENT,
@@ -67,9 +78,11 @@ public:
 		IN_NULL,
 		AFTER_VALUE,
 		UNICODE_SURROGATE,
+		SKIP,	 ///< Skipping content of an object or array
+		RECOVER, ///< Discarding remainder of a record following an error in multi-document mode
 	};
 
-	StreamingParser(char* buffer, uint16_t bufsize, Listener* listener, void* param = nullptr)
+	BasicStreamingParser(char* buffer, uint16_t bufsize, ListenerT* listener, void* param = nullptr)
 		: buffer(buffer), bufsize(bufsize), listener(listener), param(param)
 	{
 	}
@@ -78,7 +91,7 @@ public:
 	 * @brief Set the current listener
 	 * @note Can change this at any time to redirect parsing output
 	 */
-	void setListener(Listener* listener)
+	void setListener(ListenerT* listener)
 	{
 		this->listener = listener;
 	}
@@ -91,20 +104,179 @@ public:
 		this->param = param;
 	}
 
+	/**
+	 * @brief Enable zero-copy keys and values
+	 *
+	 * When enabled, keys and string values which are contained entirely within the block
+	 * passed to `parse(const char*, unsigned)` and have no escapes are passed to the listener
+	 * directly from the input, without copying into the parser buffer.
+	 * Such values are not NUL-terminated: see `Element::keyIsView` and `Element::valueIsView`.
+	 */
+	void setZeroCopy(bool enable)
+	{
+		zeroCopy = enable;
+	}
+
+	/**
+	 * @brief Enable parsing of multiple documents, such as concatenated or newline-delimited JSON (NDJSON)
+	 * @param enable Set to parse a sequence of documents
+	 * @param newlineDelimited Set if each document occupies a single line. A newline within a document then
+	 * fails with `Status::UnexpectedEndOfRecord`, so a truncated record does not consume the one following.
+	 * Otherwise document boundaries are determined by structure alone.
+	 *
+	 * When enabled, the parser is ready for another document as soon as one has been completed,
+	 * so `parse()` does not return `Status::EndOfDocument`.
+	 * The end of each document is indicated by a call to `endElement()` with `level` 0,
+	 * and `getDocumentCount()` gives the number of documents seen so far.
+	 *
+	 * If an error is encountered the listener's `documentError()` method is called.
+	 * If this returns true, the remainder of the line is discarded and parsing continues
+	 * with the next line.
+	 */
+	void setMultiDocument(bool enable, bool newlineDelimited = false)
+	{
+		multiDocument = enable;
+		this->newlineDelimited = enable && newlineDelimited;
+	}
+
+	/**
+	 * @brief Get number of documents completed, or discarded by `documentError()`, since the last `reset()`
+	 */
+	unsigned getDocumentCount() const
+	{
+		return documentCount;
+	}
+
+	/**
+	 * @brief Parse a block of content
+	 * @retval Status
+	 * 	- `Status::Ok` if all content was parsed and more is required
+	 * 	- `Status::Paused` if the listener called `ListenerBase::pause()`
+	 * 	- `Status::EndOfDocument` once the document is complete
+	 * 	- otherwise the parsing error
+	 */
 	Status parse(const char* data, unsigned length);
 
+	/**
+	 * @brief Parse a block of content, reporting how much was used
+	 * @param consumed On return, number of characters processed.
+	 * Following `Status::Paused` or `Status::EndOfDocument`, parsing resumes from `data + consumed`.
+	 * @retval Status As for `parse(const char*, unsigned)`
+	 */
+	Status parse(const char* data, unsigned length, unsigned& consumed)
+	{
+		auto start = offset;
+		auto status = parse(data, length);
+		consumed = offset - start;
+		return status;
+	}
+
+	/**
+	 * @brief Parse content read from a stream
+	 *
+	 * Data is read in blocks of `JSON_STREAM_CHUNK_SIZE` bytes using a buffer on the stack.
+	 * This blocks until the stream is exhausted, so listener requests to pause are ignored.
+	 */
 	Status parse(Stream& stream);
 
+	/**
+	 * @brief Parse content currently available from a stream, without blocking
+	 *
+	 * Content is examined using `readMemoryBlock()`, and the stream advanced only past
+	 * the characters parsed. This allows a listener to pause parsing, leaving the remainder in the stream.
+	 *
+	 * @retval Status
+	 * 	- `Status::NoMoreData` if all available content was parsed and more is required
+	 * 	- `Status::Paused` if the listener called `ListenerBase::pause()`
+	 * 	- `Status::EndOfDocument` once the document is complete
+	 * 	- otherwise the parsing error
+	 */
+	Status parseAvailable(IDataSourceStream& stream);
+
+	/**
+	 * @brief Parse content directly from the buffer of a memory stream, without copying
+	 * @param stream Stream providing `getStreamPointer()`, such as `MemoryDataStream`
+	 * @retval Status As for `parse(Stream&)`. The stream read position is advanced past the characters parsed.
+	 */
+	template <class MemoryStream>
+	auto parse(MemoryStream& stream) -> decltype(stream.getStreamPointer(), Status())
+	{
+		auto data = stream.getStreamPointer();
+		int length = stream.available();
+		if(data == nullptr || length <= 0) {
+			return Status::NoMoreData;
+		}
+		auto start = offset;
+		auto status = parse(data, length);
+		stream.seek(offset - start);
+		return (status == Status::Ok) ? Status::NoMoreData : status;
+	}
+
 	void reset();
 
+	/**
+	 * @brief Get the most buffer space occupied by a key and value since the last `reset()`
+	 *
+	 * Use to choose a buffer size for a particular kind of document.
+	 * Keys and values passed by reference with zero-copy enabled do not occupy the buffer.
+	 */
+	uint16_t getPeakBufferUsage() const
+	{
+		return peakBufferPos;
+	}
+
+	/**
+	 * @brief Skip content of the object or array which has just been started
+	 *
+	 * Equivalent to calling `ListenerBase::skipElement()` from within `startElement()`,
+	 * for callers which inspect elements afterwards, such as `Reader`.
+	 * Must be called before any content of the object or array has been parsed.
+	 *
+	 * @retval bool false if the parser is not at the start of an object or array
+	 */
+	bool skipContainer();
+
 	State getState() const
 	{
 		return state;
 	}
 
+	/**
+	 * @brief Get position in input of the next character to be parsed
+	 *
+	 * This is the total number of bytes passed to `parse()` since the last `reset()`,
+	 * plus any value set using `setOffset()`.
+	 */
+	size_t getOffset() const
+	{
+		return offset;
+	}
+
+	/**
+	 * @brief Set position of the next character to be parsed
+	 *
+	 * Use when parsing a fragment of a larger document so that `Element::offset`
+	 * and `Element::endOffset` give positions within the whole document.
+	 */
+	void setOffset(size_t offset)
+	{
+		this->offset = offset;
+	}
+
 private:
 	Status parse(char c);
 
+	Status parseBlock(const char* data, unsigned length);
+
+	/*
+	 * For newline-delimited documents, truncate a run of content at the end of the record
+	 */
+	const char* findRecordEnd(const char* data, const char* end);
+
+	void resetDocument();
+
+	Status nextDocument(Status status);
+
 	// valid whitespace characters in JSON (from RFC4627 for JSON) include:
 	// space, horizontal tab, line feed or new line, and carriage return.
 	// thanks:
@@ -116,6 +288,14 @@ private:
 
 	Status bufferChar(char c);
 
+	Status bufferChars(const char* data, unsigned length);
+
+	Status bufferKeyView();
+
+	Status flushSegment();
+
+	void initElement(Element& elem, Element::Type type);
+
 	Status startElement(Element::Type type);
 
 	Status endElement(Element::Type type);
@@ -138,26 +318,57 @@ private:
 
 	Status endUnicodeSurrogateInterstitial();
 
-	bool bufferContains(char c);
-
 	static unsigned getHexArrayAsDecimal(char hexArray[], unsigned length);
 
 	Status processUnicodeCharacter(char c);
 
 	Status endObject();
 
+	void startSkip();
+
+	Status skipChar(char c);
+
 private:
 	// Buffer contains key, followed by value data
 	char* buffer;
 	uint16_t bufsize;
 
-	Listener* listener = nullptr;
+	ListenerT* listener = nullptr;
 	void* param = nullptr;
 	State state = State::START_DOCUMENT;
-	Stack<Container, maxNesting> stack;
+	ContainerStack<maxNesting, Counter> stack;
+
+	NumberState number{};
 
 	uint8_t keyLength = 0;  ///< Length of key, not including NUL terminator
 	uint16_t bufferPos = 0; ///< Current write position in buffer
+	uint16_t peakBufferPos = 0;
+
+	// Zero-copy key and value, referring to caller's input
+	const char* keyView = nullptr;
+	const char* valueView = nullptr;
+	uint16_t keyViewLength = 0;
+	uint16_t valueViewLength = 0;
+	bool zeroCopy = false;
+	bool segmented = false; ///< Current string value is being passed to listener in segments
+	State stringState = State::IN_STRING; ///< IN_KEY or IN_STRING whilst processing escapes
+	bool skipRequested = false;
+	bool pauseRequested = false;
+	bool multiDocument = false;
+	bool newlineDelimited = false;
+	unsigned documentCount = 0;
+	size_t offset = 0;	   ///< Position in input of character being parsed
+	size_t tokenStart = 0; ///< Position of first character of current value
+
+	/**
+	 * @brief Tracks nesting whilst skipping content
+	 */
+	struct SkipState {
+		uint32_t depth;
+		bool inString;
+		bool escape;
+	};
+	SkipState skip{};
 
 	char unicodeEscapeBuffer[10];
 	uint8_t unicodeEscapeBufferPos = 0;
@@ -167,12 +378,25 @@ private:
 	int unicodeHighSurrogate = 0;
 };
 
-template <uint16_t BUFSIZE> class StaticStreamingParser : public StreamingParser
+using StreamingParser = BasicStreamingParser<Listener>;
+
+/**
+ * @brief Streaming parser with internal buffer
+ * @tparam BUFSIZE Size of buffer must be large enough to contain the longest
+ * key and value strings in the content being parsed.
+ * Longer string values may be handled using `Listener::stringSegment()`.
+ * @tparam ListenerT Type of listener
+ * @tparam nestingLimit Maximum nesting depth
+ * @tparam Counter Type used to count children
+ */
+template <uint16_t BUFSIZE, class ListenerT = Listener, unsigned nestingLimit = 20, typename Counter = uint8_t>
+class StaticStreamingParser : public BasicStreamingParser<ListenerT, nestingLimit, Counter>
 {
 public:
 	static_assert(BUFSIZE >= 32, "Buffer too small");
 
-	StaticStreamingParser(Listener* listener, void* param = nullptr) : StreamingParser(buffer, BUFSIZE, listener, param)
+	StaticStreamingParser(ListenerT* listener, void* param = nullptr)
+		: BasicStreamingParser<ListenerT, nestingLimit, Counter>(buffer, BUFSIZE, listener, param)
 	{
 	}
 
@@ -180,4 +404,8 @@ private:
 	char buffer[BUFSIZE];
 };
 
+extern template class BasicStreamingParser<Listener>;
+
 } // namespace JSON
+
+#include "StreamingParser.hpp"
@@ -0,0 +1,986 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 by Daniel Eichhorn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 	The above copyright notice and this permission notice shall be included in all
+ * 	copies or substantial portions of the Software.
+ *
+ * 	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * 	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * 	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * 	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * 	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * 	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * 	SOFTWARE.
+ *
+ * 	See more at http://blog.squix.ch and https://github.com/squix78/json-streaming-parser
+ *
+ * @author Oct 2019 / 2024 mikee47 <mike@sillyhouse.net>
+ *
+ * Substantial rewrite
+*/
+
+#pragma once
+
+#include "StreamingParser.h"
+#include "Scan.h"
+#include <algorithm>
+
+namespace JSON
+{
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::bufferChar(char c)
+{
+	if(bufferPos + 1 >= bufsize) {
+		auto status = flushSegment();
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	buffer[bufferPos++] = c;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::bufferChars(const char* data, unsigned length)
+{
+	while(bufferPos + length >= bufsize) {
+		unsigned space = bufsize - 1 - bufferPos;
+		memcpy(&buffer[bufferPos], data, space);
+		bufferPos += space;
+		data += space;
+		length -= space;
+		auto status = flushSegment();
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	memcpy(&buffer[bufferPos], data, length);
+	bufferPos += length;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::flushSegment()
+{
+	peakBufferPos = std::max(peakBufferPos, bufferPos);
+
+	bool inStringValue;
+	switch(state) {
+	case State::START_ESCAPE:
+	case State::UNICODE:
+	case State::UNICODE_SURROGATE:
+		// stringState is only meaningful whilst processing escapes
+		inStringValue = (stringState == State::IN_STRING);
+		break;
+	default:
+		inStringValue = (state == State::IN_STRING);
+	}
+	if(!inStringValue || bufferPos <= keyLength + 1) {
+		return Status::BufferFull;
+	}
+
+	if(listener != nullptr) {
+		Element elem;
+		initElement(elem, Element::Type::String);
+		if(!listener->stringSegment(elem, false)) {
+			// Listener doesn't support segments, or wants to stop
+			return segmented ? Status::Cancelled : Status::BufferFull;
+		}
+		if(listener->checkPause()) {
+			pauseRequested = true;
+		}
+	}
+
+	segmented = true;
+	bufferPos = keyLength + 1;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::startObject()
+{
+	auto status = startElement(Element::Type::Object);
+	if(status == Status::Ok) {
+		if(skipRequested) {
+			startSkip();
+			return Status::Ok;
+		}
+		state = State::IN_OBJECT;
+		status = stack.push(true) ? Status::Ok : Status::StackFull;
+	}
+	return status;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::startArray()
+{
+	auto status = startElement(Element::Type::Array);
+	if(status == Status::Ok) {
+		if(skipRequested) {
+			startSkip();
+			return Status::Ok;
+		}
+		state = State::IN_ARRAY;
+		status = stack.push(false) ? Status::Ok : Status::StackFull;
+	}
+	return status;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+void BasicStreamingParser<ListenerT, nestingLimit, Counter>::startSkip()
+{
+	state = State::SKIP;
+	skip = {1, false, false};
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+bool BasicStreamingParser<ListenerT, nestingLimit, Counter>::skipContainer()
+{
+	if((state != State::IN_OBJECT && state != State::IN_ARRAY) || stack.peek().index != 0) {
+		return false;
+	}
+
+	stack.pop();
+	startSkip();
+	return true;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::skipChar(char c)
+{
+	if(skip.inString) {
+		if(skip.escape) {
+			skip.escape = false;
+		} else if(c == '\\') {
+			skip.escape = true;
+		} else if(c == '"') {
+			skip.inString = false;
+		}
+		return Status::Ok;
+	}
+
+	switch(c) {
+	case '"':
+		skip.inString = true;
+		break;
+	case '[':
+	case '{':
+		++skip.depth;
+		break;
+	case ']':
+	case '}':
+		if(--skip.depth == 0) {
+			state = State::AFTER_VALUE;
+			if(stack.isEmpty()) {
+				state = State::END_DOCUMENT;
+				return Status::EndOfDocument;
+			}
+		}
+		break;
+	default:;
+	}
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+void BasicStreamingParser<ListenerT, nestingLimit, Counter>::reset()
+{
+	resetDocument();
+	offset = 0;
+	documentCount = 0;
+	pauseRequested = false;
+	peakBufferPos = 0;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+void BasicStreamingParser<ListenerT, nestingLimit, Counter>::resetDocument()
+{
+	state = State::START_DOCUMENT;
+	stack.clear();
+	keyLength = 0;
+	bufferPos = 0;
+	keyView = nullptr;
+	valueView = nullptr;
+	segmented = false;
+	unicodeEscapeBufferPos = 0;
+	unicodeBufferPos = 0;
+	tokenStart = 0;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::nextDocument(Status status)
+{
+	if(status == Status::EndOfDocument) {
+		++documentCount;
+		state = State::START_DOCUMENT;
+		return Status::Ok;
+	}
+
+	if(status == Status::Cancelled || listener == nullptr || !listener->documentError(status)) {
+		return status;
+	}
+
+	// Discard remainder of record
+	++documentCount;
+	resetDocument();
+	state = State::RECOVER;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::parse(const char* data, unsigned length)
+{
+	if(!multiDocument) {
+		return parseBlock(data, length);
+	}
+
+	auto end = data + length;
+	for(;;) {
+		auto start = offset;
+		auto status = parseBlock(data, end - data);
+		if(status == Status::Ok || status == Status::Paused) {
+			return status;
+		}
+		data += offset - start;
+		status = nextDocument(status);
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+const char* BasicStreamingParser<ListenerT, nestingLimit, Counter>::findRecordEnd(const char* data, const char* end)
+{
+	if(!newlineDelimited) {
+		return end;
+	}
+	auto newline = static_cast<const char*>(memchr(data, '\n', end - data));
+	return newline ? newline : end;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::parseBlock(const char* data, unsigned length)
+{
+	auto end = data + length;
+	while(data < end && !pauseRequested) {
+		switch(state) {
+		case State::IN_KEY:
+		case State::IN_STRING: {
+			// Copy plain content in one go, leaving the terminating character for the state machine
+			auto run = Scan::findStringSpecial(data, end);
+			if(zeroCopy && !segmented && run != end && *run == '"') {
+				if(state == State::IN_KEY && bufferPos == 0) {
+					keyView = data;
+					keyViewLength = run - data;
+					keyLength = 0;
+					buffer[bufferPos++] = '\0';
+					state = State::END_KEY;
+					offset += run + 1 - data;
+					data = run + 1;
+					continue;
+				}
+				if(state == State::IN_STRING && bufferPos == keyLength + 1) {
+					valueView = data;
+					valueViewLength = run - data;
+					offset += run - data;
+					data = run + 1;
+					auto status = startElement(Element::Type::String);
+					++offset;
+					if(status != Status::Ok) {
+						return status;
+					}
+					continue;
+				}
+			}
+			// Leave segment boundaries to the state machine, so a pause takes effect immediately
+			unsigned space = (bufferPos + 1 < bufsize) ? bufsize - 1 - bufferPos : 0;
+			if(unsigned(run - data) > space) {
+				run = data + space;
+			}
+			if(run != data) {
+				auto status = bufferChars(data, run - data);
+				if(status != Status::Ok) {
+					return status;
+				}
+				offset += run - data;
+				data = run;
+				continue;
+			}
+			break;
+		}
+
+		case State::IN_NUMBER: {
+			auto run = Scan::findNonDigit(data, end);
+			if(run != data) {
+				auto status = bufferChars(data, run - data);
+				if(status != Status::Ok) {
+					return status;
+				}
+				number.addDigits(data, run - data);
+				offset += run - data;
+				data = run;
+				continue;
+			}
+			break;
+		}
+
+		case State::SKIP: {
+			if(skip.escape) {
+				break;
+			}
+			auto next = findRecordEnd(data, Scan::findSkipSpecial(data, end));
+			offset += next - data;
+			data = next;
+			if(data == end) {
+				continue;
+			}
+			break;
+		}
+
+		case State::START_DOCUMENT:
+		case State::END_DOCUMENT:
+		case State::IN_ARRAY:
+		case State::IN_OBJECT:
+		case State::END_KEY:
+		case State::AFTER_KEY:
+		case State::AFTER_VALUE: {
+			// Whitespace between tokens is ignored
+			auto next = Scan::skipWhitespace(data, end);
+			if(state != State::START_DOCUMENT) {
+				next = findRecordEnd(data, next);
+			}
+			offset += next - data;
+			data = next;
+			if(data == end) {
+				continue;
+			}
+			break;
+		}
+
+		case State::RECOVER: {
+			auto next = static_cast<const char*>(memchr(data, '\n', end - data));
+			if(next == nullptr) {
+				next = end;
+			}
+			offset += next - data;
+			data = next;
+			if(data == end) {
+				continue;
+			}
+			break;
+		}
+
+		default:;
+		}
+
+		if(*data == '\n' && newlineDelimited && state != State::START_DOCUMENT && state != State::RECOVER) {
+			// Record is incomplete
+			return Status::UnexpectedEndOfRecord;
+		}
+
+		auto status = parse(*data++);
+		++offset;
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	// Input may not persist beyond this call
+	auto status = keyView ? bufferKeyView() : Status::Ok;
+	if(status == Status::Ok && pauseRequested) {
+		pauseRequested = false;
+		status = Status::Paused;
+	}
+	return status;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::bufferKeyView()
+{
+	// Buffer contains NUL key terminator followed by any value content
+	if(keyViewLength > UINT8_MAX) {
+		return Status::BufferFull;
+	}
+	if(bufferPos + keyViewLength >= bufsize) {
+		// Make room by passing value content to listener
+		auto status = flushSegment();
+		if(status != Status::Ok) {
+			return status;
+		}
+		if(bufferPos + keyViewLength >= bufsize) {
+			return Status::BufferFull;
+		}
+	}
+	memmove(&buffer[keyViewLength], buffer, bufferPos);
+	memcpy(buffer, keyView, keyViewLength);
+	keyLength = keyViewLength;
+	bufferPos += keyViewLength;
+	keyView = nullptr;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::parse(Stream& stream)
+{
+	char buffer[JSON_STREAM_CHUNK_SIZE];
+	while(auto len = stream.readBytes(buffer, sizeof(buffer))) {
+		Status status;
+		unsigned consumed;
+		for(auto data = buffer; (status = parse(data, len, consumed)) == Status::Paused;) {
+			data += consumed;
+			len -= consumed;
+		}
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	return Status::NoMoreData;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::parseAvailable(IDataSourceStream& stream)
+{
+	char buffer[JSON_STREAM_CHUNK_SIZE];
+	for(;;) {
+		auto len = stream.readMemoryBlock(buffer, sizeof(buffer));
+		if(len == 0) {
+			return Status::NoMoreData;
+		}
+		unsigned consumed;
+		auto status = parse(buffer, len, consumed);
+		stream.seek(consumed);
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::parse(char c)
+{
+	switch(state) {
+	case State::IN_KEY:
+	case State::IN_STRING:
+		if(isWhiteSpace(c)) {
+			return bufferChar(c);
+		}
+		if(c == '"') {
+			if(state == State::IN_KEY) {
+				keyLength = bufferPos;
+				buffer[bufferPos++] = '\0';
+				state = State::END_KEY;
+				return Status::Ok;
+			}
+			return startElement(Element::Type::String);
+		}
+		if(c == '\\') {
+			stringState = state;
+			state = State::START_ESCAPE;
+			return Status::Ok;
+		}
+		if(uint8_t(c) < 0x1f || c == 0x7f) {
+			// Unescaped control character encountered
+			return Status::UnescapedControl;
+		}
+		return bufferChar(c);
+
+	case State::IN_ARRAY:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		if(c == ']') {
+			return endArray();
+		}
+		return startValue(c);
+
+	case State::IN_OBJECT:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		if(c == '}') {
+			return endObject();
+		}
+		if(c == '"') {
+			state = State::IN_KEY;
+			return Status::Ok;
+		}
+		// Start of string expected for object key
+		return Status::StringStartExpected;
+
+	case State::END_KEY:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		if(c == ':') {
+			state = State::AFTER_KEY;
+			return Status::Ok;
+		}
+		// Expected ':' after key
+		return Status::ColonExpected;
+
+	case State::AFTER_KEY:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		return startValue(c);
+
+	case State::START_ESCAPE:
+		return processEscapeCharacters(c);
+
+	case State::UNICODE:
+		return processUnicodeCharacter(c);
+
+	case State::SKIP:
+		return skipChar(c);
+
+	case State::RECOVER:
+		if(c == '\n') {
+			state = State::START_DOCUMENT;
+		}
+		return Status::Ok;
+
+	case State::UNICODE_SURROGATE:
+		unicodeEscapeBuffer[unicodeEscapeBufferPos++] = c;
+		if(unicodeEscapeBufferPos == 2) {
+			return endUnicodeSurrogateInterstitial();
+		}
+		return Status::Ok;
+
+	case State::AFTER_VALUE:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		if(stack.peek().isObject) {
+			if(c == '}') {
+				return endObject();
+			}
+			if(c == ',') {
+				state = State::IN_OBJECT;
+				return Status::Ok;
+			}
+			// Expected ',' or '}'
+			return Status::CommaOrClosingBraceExpected;
+		}
+		if(c == ']') {
+			return endArray();
+		}
+		if(c == ',') {
+			state = State::IN_ARRAY;
+			return Status::Ok;
+		}
+		// Expected ',' or ']' while parsing array
+		return Status::CommaOrClosingBracketExpected;
+
+	case State::IN_NUMBER: {
+		if(isdigit(c)) {
+			number.addDigits(&c, 1);
+			return bufferChar(c);
+		}
+		if(c == '.') {
+			if(number.hasPoint) {
+				// Cannot have multiple decimal points in a number
+				return Status::MultipleDecimalPoints;
+			}
+			if(number.hasExponent) {
+				// Cannot have a decimal point in an exponent
+				return Status::DecimalPointInExponent;
+			}
+			number.hasPoint = true;
+			return bufferChar(c);
+		}
+		if(c == 'e' || c == 'E') {
+			if(number.hasExponent) {
+				// Cannot have multiple exponents in a number
+				return Status::MultipleExponents;
+			}
+			number.hasExponent = true;
+			return bufferChar('e');
+		}
+		if(c == '+' || c == '-') {
+			char last = buffer[bufferPos - 1];
+			if(last != 'e') {
+				// Can only have '+' or '-' after the 'e' or 'E' in a number
+				return Status::BadExponent;
+			}
+			number.exponentIsNegative = (c == '-');
+			return bufferChar(c);
+		}
+		auto status = startElement(Element::Type::Number);
+		if(status == Status::Ok) {
+			// we have consumed one beyond the end of the number
+			status = parse(c);
+		}
+		return status;
+	}
+
+	case State::IN_TRUE:
+		return specialValue(c, "true", 4, Element::Type::True, Status::TrueExpected);
+
+	case State::IN_FALSE:
+		return specialValue(c, "false", 5, Element::Type::False, Status::FalseExpected);
+
+	case State::IN_NULL:
+		return specialValue(c, "null", 4, Element::Type::Null, Status::NullExpected);
+
+	case State::START_DOCUMENT:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		tokenStart = offset;
+		if(c == '[') {
+			return startArray();
+		}
+		if(c == '{') {
+			return startObject();
+		}
+		// Document must start with object or array
+		return Status::OpeningBraceExpected;
+
+	case State::END_DOCUMENT:
+		if(isWhiteSpace(c)) {
+			return Status::Ok;
+		}
+		return Status::UnexpectedContentAfterDocument;
+	}
+
+	// Reached an unknown state
+	assert(false);
+	return Status::InternalError;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+void BasicStreamingParser<ListenerT, nestingLimit, Counter>::initElement(Element& elem, Element::Type type)
+{
+	buffer[bufferPos] = '\0';
+	elem.param = param;
+	elem.type = type;
+	elem.level = stack.getLevel();
+	elem.key = buffer;
+	elem.value = &buffer[keyLength + 1];
+	elem.keyLength = keyLength;
+	elem.offset = tokenStart;
+	if(elem.level > 0) {
+		elem.container = stack.peek();
+	}
+	if(bufferPos > keyLength) {
+		elem.valueLength = uint16_t(bufferPos - keyLength - 1);
+	}
+	if(keyView) {
+		elem.key = keyView;
+		elem.keyLength = keyViewLength;
+		elem.keyIsView = true;
+	}
+	if(valueView) {
+		elem.value = valueView;
+		elem.valueLength = valueViewLength;
+		elem.valueIsView = true;
+	}
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::startElement(Element::Type type)
+{
+	if(listener != nullptr) {
+		Element elem;
+		initElement(elem, type);
+		if(elem.level > 0) {
+			stack.increment();
+		}
+		switch(type) {
+		case Element::Type::Number:
+			// Number is terminated by the following character
+			elem.number = number.getNumber(&buffer[keyLength + 1]);
+			elem.endOffset = offset;
+			break;
+		case Element::Type::Object:
+		case Element::Type::Array:
+			break;
+		default:
+			elem.endOffset = offset + 1;
+		}
+		bool ok = segmented ? listener->stringSegment(elem, true) : listener->startElement(elem);
+		if(!ok) {
+			return Status::Cancelled;
+		}
+		skipRequested = listener->checkSkip();
+		if(listener->checkPause()) {
+			pauseRequested = true;
+		}
+	}
+
+	state = State::AFTER_VALUE;
+	peakBufferPos = std::max(peakBufferPos, bufferPos);
+	keyLength = 0;
+	bufferPos = 0;
+	keyView = nullptr;
+	valueView = nullptr;
+	segmented = false;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::endElement(Element::Type type)
+{
+	if(listener != nullptr) {
+		Element elem;
+		elem.param = param;
+		elem.type = type;
+		elem.level = stack.getLevel();
+		elem.endOffset = offset + 1;
+		if(!listener->endElement(elem)) {
+			return Status::Cancelled;
+		}
+		if(listener->checkPause()) {
+			pauseRequested = true;
+		}
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::startValue(char c)
+{
+	// Add an empty key if one wasn't provided
+	if(bufferPos == 0) {
+		keyLength = 0;
+		buffer[bufferPos++] = '\0';
+	}
+
+	tokenStart = offset;
+	if(c == '[') {
+		return startArray();
+	}
+	if(c == '{') {
+		return startObject();
+	}
+	if(c == '"') {
+		state = State::IN_STRING;
+		return Status::Ok;
+	}
+	if(isdigit(c) || c == '-') {
+		state = State::IN_NUMBER;
+		number = {};
+		if(c == '-') {
+			number.value.isNegative = true;
+		} else {
+			number.addDigits(&c, 1);
+		}
+		return bufferChar(c);
+	}
+	if(c == 't') {
+		state = State::IN_TRUE;
+		return bufferChar(c);
+	}
+	if(c == 'f') {
+		state = State::IN_FALSE;
+		return bufferChar(c);
+	}
+	if(c == 'n') {
+		state = State::IN_NULL;
+		return bufferChar(c);
+	}
+	// Unexpected character for value
+	return Status::BadValue;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::specialValue(char c, const char* tag, uint8_t taglen,
+																	 Element::Type type, Status fail)
+{
+	if(isWhiteSpace(c)) {
+		return Status::Ok;
+	}
+	bufferChar(c);
+	if(bufferPos < keyLength + 1 + taglen) {
+		return Status::Ok;
+	}
+	if(memcmp(&buffer[keyLength + 1], tag, taglen) == 0) {
+		return startElement(type);
+	}
+	return fail;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::endArray()
+{
+	if(stack.pop().isObject) {
+		// "Unexpected end of array encountered.");
+		return Status::NotInArray;
+	}
+
+	auto status = endElement(Element::Type::Array);
+	if(status != Status::Ok) {
+		return status;
+	}
+	state = State::AFTER_VALUE;
+	if(stack.isEmpty()) {
+		state = State::END_DOCUMENT;
+		return Status::EndOfDocument;
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::endObject()
+{
+	if(!stack.pop().isObject) {
+		// Unexpected end of object encountered
+		return Status::NotInObject;
+	}
+
+	auto status = endElement(Element::Type::Object);
+	if(status != Status::Ok) {
+		return status;
+	}
+	state = State::AFTER_VALUE;
+	if(stack.isEmpty()) {
+		state = State::END_DOCUMENT;
+		return Status::EndOfDocument;
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::processEscapeCharacters(char c)
+{
+	switch(c) {
+	case '"':
+	case '\\':
+	case '/':
+		break;
+	case 'b':
+		c = 0x08;
+		break;
+	case 'f':
+		c = '\f';
+		break;
+	case 'n':
+		c = '\n';
+		break;
+	case 'r':
+		c = '\r';
+		break;
+	case 't':
+		c = '\t';
+		break;
+	case 'u':
+		state = State::UNICODE;
+		return Status::Ok;
+	default:
+		// Expected escaped character after backslash
+		return Status::BadEscapeChar;
+	}
+
+	if(state != State::UNICODE) {
+		state = stringState;
+	}
+
+	return bufferChar(c);
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::processUnicodeCharacter(char c)
+{
+	if(!isxdigit(c)) {
+		// Expected hex character for escaped Unicode character
+		return Status::HexExpected;
+	}
+
+	unicodeBuffer[unicodeBufferPos] = c;
+	unicodeBufferPos++;
+
+	if(unicodeBufferPos == 4) {
+		unsigned codepoint = getHexArrayAsDecimal(unicodeBuffer, unicodeBufferPos);
+		return endUnicodeCharacter(codepoint);
+
+		/*if (codepoint >= 0xD800 && codepoint < 0xDC00) {
+        unicodeHighSurrogate = codepoint;
+        unicodeBufferPos = 0;
+        state = State::UNICODE_SURROGATE;
+      } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+        if (unicodeHighSurrogate == -1) {
+          // throw new ParsingError($this->_line_number,
+          // $this->_char_number,
+          // "Missing high surrogate for Unicode low surrogate.");
+        }
+        int combinedCodePoint = ((unicodeHighSurrogate - 0xD800) * 0x400) + (codepoint - 0xDC00) + 0x10000;
+        endUnicodeCharacter(combinedCodePoint);
+      } else if (unicodeHighSurrogate != -1) {
+        // throw new ParsingError($this->_line_number,
+        // $this->_char_number,
+        // "Invalid low surrogate following Unicode high surrogate.");
+        endUnicodeCharacter(codepoint);
+      } else {
+        endUnicodeCharacter(codepoint);
+      }*/
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+unsigned BasicStreamingParser<ListenerT, nestingLimit, Counter>::getHexArrayAsDecimal(char hexArray[], unsigned length)
+{
+	unsigned result = 0;
+	for(unsigned i = 0; i < length; i++) {
+		result = (result << 4) | unhex(hexArray[i]);
+	}
+	return result;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::endUnicodeSurrogateInterstitial()
+{
+	char unicodeEscape = unicodeEscapeBuffer[unicodeEscapeBufferPos - 1];
+	if(unicodeEscape != 'u') {
+		// throw new ParsingError($this->_line_number, $this->_char_number,
+		// "Expected '\\u' following a Unicode high surrogate. Got: " .
+		// $unicode_escape);
+		return Status::BadUnicodeEscapeChar;
+	}
+	unicodeBufferPos = 0;
+	unicodeEscapeBufferPos = 0;
+	state = State::UNICODE;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStreamingParser<ListenerT, nestingLimit, Counter>::endUnicodeCharacter(uint16_t codepoint)
+{
+	unicodeBufferPos = 0;
+	unicodeHighSurrogate = -1;
+	state = stringState;
+	return bufferChar(convertCodepointToCharacter(codepoint));
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+char BasicStreamingParser<ListenerT, nestingLimit, Counter>::convertCodepointToCharacter(uint16_t num)
+{
+	if(num <= 0x7F) {
+		return char(num);
+	}
+	// if(num<=0x7FF) return (char)((num>>6)+192) + (char)((num&63)+128);
+	// if(num<=0xFFFF) return
+	// chr((num>>12)+224).chr(((num>>6)&63)+128).chr((num&63)+128);
+	// if(num<=0x1FFFFF) return
+	// chr((num>>18)+240).chr(((num>>12)&63)+128).chr(((num>>6)&63)+128).chr((num&63)+128);
+	return ' ';
+}
+
+} // namespace JSON
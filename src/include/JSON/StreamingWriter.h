@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Element.h"
+#include "Status.h"
+#include "ContainerStack.h"
+#include <Print.h>
+#include <cstring>
+
+namespace JSON
+{
+/**
+ * @brief Writes JSON to a `Print` output via a fixed buffer, without using the heap
+ *
+ * Example::
+ *
+ * 	JSON::StaticStreamingWriter<64> writer(Serial);
+ * 	writer.beginObject();
+ * 	writer.key("ssid");
+ * 	writer.value(ssid);
+ * 	writer.key("channels");
+ * 	writer.beginArray();
+ * 	writer.value(1);
+ * 	writer.value(6);
+ * 	writer.endArray();
+ * 	writer.endObject();
+ * 	auto status = writer.flush();
+ *
+ * Separators are inserted automatically. Within an object, each value must be preceded by a call to `key()`.
+ * Output is compact unless an indent is set using `setIndent()`.
+ *
+ * Errors are sticky: once a call fails, all subsequent calls do nothing and return the same status.
+ * Misuse is reported as:
+ *
+ * - `Status::NotInObject`, `Status::NotInArray` for a mismatched `key()`, `endObject()` or `endArray()`
+ * - `Status::StringStartExpected` for a value in an object without a key
+ * - `Status::BadValue` for a key without a value
+ * - `Status::UnexpectedContentAfterDocument` for a second top-level value
+ * - `Status::UnexpectedEndOfString` if anything else is written before the final string segment
+ * - `Status::StackFull` if nesting exceeds `maxNesting`
+ * - `Status::WriteFailed` if the output does not accept all data
+ */
+class StreamingWriter
+{
+public:
+	static constexpr unsigned maxNesting{32};
+
+	StreamingWriter(Print& output, char* buffer, uint16_t bufsize) : output(output), buffer(buffer), bufsize(bufsize)
+	{
+	}
+
+	~StreamingWriter()
+	{
+		flush();
+	}
+
+	/**
+	 * @brief Set number of spaces to indent each nesting level
+	 * @param spaces 0 for compact output (the default)
+	 */
+	void setIndent(uint8_t spaces)
+	{
+		indent = spaces;
+	}
+
+	Status beginObject();
+
+	Status endObject();
+
+	Status beginArray();
+
+	Status endArray();
+
+	/**
+	 * @brief Write key for the following value
+	 */
+	Status key(const char* key, unsigned length);
+
+	Status key(const char* key)
+	{
+		return this->key(key, strlen(key));
+	}
+
+	Status key(const String& key)
+	{
+		return this->key(key.c_str(), key.length());
+	}
+
+	/**
+	 * @brief Write a string value, escaped as required
+	 */
+	Status value(const char* value, unsigned length);
+
+	Status value(const char* value)
+	{
+		return (value == nullptr) ? nullValue() : this->value(value, strlen(value));
+	}
+
+	Status value(const String& value)
+	{
+		return this->value(value.c_str(), value.length());
+	}
+
+	/**
+	 * @brief Write an integer value
+	 */
+	template <typename T> auto value(T number) -> typename std::enable_if<std::is_integral<T>::value, Status>::type
+	{
+		return std::is_signed<T>::value ? integerValue(int64_t(number)) : unsignedValue(uint64_t(number));
+	}
+
+	Status value(bool value)
+	{
+		return value ? rawValue("true", 4) : rawValue("false", 5);
+	}
+
+	/**
+	 * @brief Write a floating-point value
+	 *
+	 * Uses the shortest representation which converts back to the same value.
+	 * Infinity and NaN cannot be represented in JSON so are written as `null`.
+	 */
+	Status value(double number);
+
+	/**
+	 * @brief Write a decimal value exactly, without using floating point
+	 */
+	Status value(const Decimal& number);
+
+	/**
+	 * @brief Write a number decoded by the parser
+	 */
+	Status value(const Number& number)
+	{
+#if JSON_FIXED_POINT
+		return value(number.decimal);
+#else
+		return number.isInteger ? integerValue(number.integer) : value(number.real);
+#endif
+	}
+
+	Status nullValue()
+	{
+		return rawValue("null", 4);
+	}
+
+	/**
+	 * @brief Write part of a string value
+	 *
+	 * Use to write strings which are too large to hold in memory, such as segments from the parser.
+	 * No other values may be written until the final segment.
+	 *
+	 * @param final true for the last segment
+	 */
+	Status stringSegment(const char* value, unsigned length, bool final);
+
+	/**
+	 * @brief Write a value which is already formatted as JSON, such as number text from the parser
+	 * @note Content is written as-is, without validation
+	 */
+	Status rawValue(const char* text, unsigned length);
+
+	/**
+	 * @brief Write any buffered content to the output
+	 */
+	Status flush();
+
+	/**
+	 * @brief Prepare to write a new document
+	 * @note Buffered content is discarded
+	 */
+	void reset();
+
+	Status getStatus() const
+	{
+		return status;
+	}
+
+	/**
+	 * @brief Get current nesting level, 0 at top level
+	 */
+	uint16_t getLevel() const
+	{
+		return stack.getLevel();
+	}
+
+private:
+	Status integerValue(int64_t number);
+
+	Status unsignedValue(uint64_t number);
+
+	Status beginValue();
+
+	void endValue()
+	{
+		if(stack.isEmpty()) {
+			complete = true;
+		}
+	}
+
+	Status beginContainer(bool isObject);
+
+	Status endContainer(bool isObject);
+
+	void writeChar(char c)
+	{
+		if(bufferPos == bufsize) {
+			flushBuffer();
+		}
+		buffer[bufferPos++] = c;
+	}
+
+	void writeChars(const char* data, unsigned length);
+
+	void writeString(const char* data, unsigned length)
+	{
+		writeChar('"');
+		writeEscaped(data, length);
+		writeChar('"');
+	}
+
+	void writeEscaped(const char* data, unsigned length);
+
+	void writeNewLine();
+
+	void flushBuffer();
+
+	Print& output;
+	char* buffer;
+	uint16_t bufsize;
+	uint16_t bufferPos{0};
+	ContainerStack<maxNesting> stack;
+	Status status{Status::Ok};
+	uint8_t indent{0};
+	bool afterKey{false}; ///< Key has been written, value required
+	bool inString{false}; ///< String segments are being written
+	bool complete{false}; ///< Top-level value has been written
+};
+
+/**
+ * @brief Streaming writer with internal buffer
+ */
+template <uint16_t BUFSIZE> class StaticStreamingWriter : public StreamingWriter
+{
+public:
+	static_assert(BUFSIZE >= 32, "Buffer too small");
+
+	StaticStreamingWriter(Print& output) : StreamingWriter(output, buffer, BUFSIZE)
+	{
+	}
+
+	~StaticStreamingWriter()
+	{
+		// Buffer is destroyed before base class destructor runs
+		flush();
+	}
+
+private:
+	char buffer[BUFSIZE];
+};
+
+} // namespace JSON
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace JSON
+{
+/**
+ * @brief Locates structural characters in a block of JSON content
+ *
+ * Content is classified 64 bytes at a time into bitmasks, using SSE2 where available.
+ * Quoted regions are identified using a prefix XOR of the unescaped quote positions,
+ * so characters within strings are never visited individually.
+ *
+ * Positions reported are:
+ *
+ * - brackets, braces, colons and commas outside strings
+ * - opening and closing quotes
+ * - the first character of any other run of non-whitespace outside strings, such as a number or `true`
+ *
+ * This is the first stage of `BasicStructuralParser`.
+ */
+class StructuralIndex
+{
+public:
+	static constexpr unsigned blockSize{64};
+
+	StructuralIndex(const char* data, size_t length) : data(data), length(length)
+	{
+	}
+
+	/**
+	 * @brief Get position of next structural character
+	 * @retval size_t Position in content, or length if there are no more
+	 */
+	size_t next()
+	{
+		while(bits == 0) {
+			if(nextBlock >= length) {
+				return length;
+			}
+			scanBlock();
+		}
+		auto pos = nextBlock - blockSize + __builtin_ctzll(bits);
+		bits &= bits - 1;
+		return pos;
+	}
+
+private:
+	void scanBlock();
+
+	const char* data;
+	size_t length;
+	size_t nextBlock{0}; ///< Position of next block to scan
+	uint64_t bits{0};	 ///< Structural positions remaining in current block
+	uint64_t prevEscaped{0};
+	uint64_t prevInString{0}; ///< All ones if previous block ended inside a string
+	uint64_t prevOther{0};	  ///< 1 if previous block ended with a non-structural character
+};
+
+} // namespace JSON
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "Listener.h"
+#include "Status.h"
+#include "ContainerStack.h"
+#include "NumberState.h"
+#include "StructuralIndex.h"
+
+namespace JSON
+{
+/**
+ * @brief Parser for complete documents held in memory, using a structural index
+ *
+ * An alternative to `BasicStreamingParser` which is considerably faster for larger documents.
+ * Instead of examining each character in turn, a `StructuralIndex` locates brackets, separators,
+ * quotes and the start of each value. Only these positions are visited, and string content is
+ * copied in runs.
+ *
+ * The listener receives the same calls, with the same elements, as from `BasicStreamingParser`
+ * given the whole document in one block. Skipped objects and arrays are passed over using the index.
+ * Errors are reported using the same status codes, but not necessarily at the same point.
+ *
+ * @tparam ListenerT Type of listener, see `BasicStreamingParser`
+ * @tparam nestingLimit Maximum nesting depth
+ * @tparam Counter Type used to count children of each object or array
+ */
+template <class ListenerT, unsigned nestingLimit = 20, typename Counter = uint8_t> class BasicStructuralParser
+{
+public:
+	static constexpr unsigned maxNesting{nestingLimit};
+
+	BasicStructuralParser(char* buffer, uint16_t bufsize, ListenerT* listener, void* param = nullptr)
+		: buffer(buffer), bufsize(bufsize), listener(listener), param(param)
+	{
+	}
+
+	void setListener(ListenerT* listener)
+	{
+		this->listener = listener;
+	}
+
+	void setParam(void* param)
+	{
+		this->param = param;
+	}
+
+	/**
+	 * @brief Enable zero-copy keys and values
+	 * @see `BasicStreamingParser::setZeroCopy()`
+	 */
+	void setZeroCopy(bool enable)
+	{
+		zeroCopy = enable;
+	}
+
+	/**
+	 * @brief Parse a complete document
+	 * @param data Document content
+	 * @param length Number of characters
+	 * @retval Status `Status::EndOfDocument` on success, `Status::NoMoreData` if the document is incomplete
+	 */
+	Status parse(const char* data, size_t length);
+
+	/**
+	 * @brief Get the most buffer space occupied by a key and value during the last call to `parse()`
+	 * @see `BasicStreamingParser::getPeakBufferUsage()`
+	 */
+	uint16_t getPeakBufferUsage() const
+	{
+		return peakBufferPos;
+	}
+
+private:
+	enum class Expect {
+		ObjectKey,	///< Key or end of object
+		Colon,		///< Separator following key
+		ArrayValue, ///< Value or end of array
+		Value,		///< Value following key
+		AfterValue, ///< Separator or end of container
+	};
+
+	static bool isWhiteSpace(char c)
+	{
+		return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+	}
+
+	/**
+	 * @brief Determine whether a character may follow a number or literal
+	 */
+	static bool isDelimiter(char c)
+	{
+		switch(c) {
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ':':
+		case ',':
+		case '"':
+			return true;
+		default:
+			return isWhiteSpace(c);
+		}
+	}
+
+	Status bufferChar(char c);
+
+	Status bufferChars(const char* data, unsigned length);
+
+	Status flushSegment();
+
+	Status copyString(const char* ptr, const char* end);
+
+	void initElement(Element& elem, Element::Type type);
+
+	Status startElement(Element::Type type);
+
+	Status endElement(Element::Type type);
+
+	Status parseKey(size_t start, size_t end);
+
+	Status parseValue(StructuralIndex& index, size_t pos);
+
+	Status parseNumber(size_t pos);
+
+	Status parseLiteral(size_t pos, const char* tag, uint8_t taglen, Element::Type type, Status fail);
+
+	Status startContainer(StructuralIndex& index, bool isObject);
+
+	Status endContainer(bool isObject);
+
+	Status skipContainer(StructuralIndex& index);
+
+	Status afterValueError()
+	{
+		return stack.peek().isObject ? Status::CommaOrClosingBraceExpected : Status::CommaOrClosingBracketExpected;
+	}
+
+	// Buffer contains key, followed by value data
+	char* buffer;
+	uint16_t bufsize;
+
+	ListenerT* listener = nullptr;
+	void* param = nullptr;
+	ContainerStack<maxNesting, Counter> stack;
+	NumberState number{};
+
+	const char* data = nullptr;
+	size_t length = 0;
+	Expect expect = Expect::Value;
+
+	uint8_t keyLength = 0;	///< Length of key, not including NUL terminator
+	uint16_t bufferPos = 0; ///< Current write position in buffer
+	uint16_t peakBufferPos = 0;
+
+	const char* keyView = nullptr;
+	const char* valueView = nullptr;
+	uint16_t keyViewLength = 0;
+	uint16_t valueViewLength = 0;
+	bool zeroCopy = false;
+	bool segmented = false;		///< Current string value is being passed to listener in segments
+	bool inStringValue = false; ///< Buffer contains string value which may be segmented
+	bool skipRequested = false;
+	size_t offset = 0;	   ///< Position of character being processed
+	size_t tokenStart = 0; ///< Position of first character of current value
+};
+
+using StructuralParser = BasicStructuralParser<Listener>;
+
+/**
+ * @brief Structural parser with internal buffer
+ * @see `StaticStreamingParser`
+ */
+template <uint16_t BUFSIZE, class ListenerT = Listener, unsigned nestingLimit = 20, typename Counter = uint8_t>
+class StaticStructuralParser : public BasicStructuralParser<ListenerT, nestingLimit, Counter>
+{
+public:
+	static_assert(BUFSIZE >= 32, "Buffer too small");
+
+	StaticStructuralParser(ListenerT* listener, void* param = nullptr)
+		: BasicStructuralParser<ListenerT, nestingLimit, Counter>(buffer, BUFSIZE, listener, param)
+	{
+	}
+
+private:
+	char buffer[BUFSIZE];
+};
+
+extern template class BasicStructuralParser<Listener>;
+
+} // namespace JSON
+
+#include "StructuralParser.hpp"
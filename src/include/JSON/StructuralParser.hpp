@@ -0,0 +1,560 @@
+#pragma once
+
+#include "StructuralParser.h"
+#include "Scan.h"
+#include <algorithm>
+
+namespace JSON
+{
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::bufferChar(char c)
+{
+	if(bufferPos + 1 >= bufsize) {
+		auto status = flushSegment();
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	buffer[bufferPos++] = c;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::bufferChars(const char* data, unsigned length)
+{
+	while(bufferPos + length >= bufsize) {
+		unsigned space = bufsize - 1 - bufferPos;
+		memcpy(&buffer[bufferPos], data, space);
+		bufferPos += space;
+		data += space;
+		length -= space;
+		auto status = flushSegment();
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	memcpy(&buffer[bufferPos], data, length);
+	bufferPos += length;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::flushSegment()
+{
+	peakBufferPos = std::max(peakBufferPos, bufferPos);
+
+	if(!inStringValue || bufferPos <= keyLength + 1) {
+		return Status::BufferFull;
+	}
+
+	if(listener != nullptr) {
+		Element elem;
+		initElement(elem, Element::Type::String);
+		if(!listener->stringSegment(elem, false)) {
+			// Listener doesn't support segments, or wants to stop
+			return segmented ? Status::Cancelled : Status::BufferFull;
+		}
+	}
+
+	segmented = true;
+	bufferPos = keyLength + 1;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::copyString(const char* ptr, const char* end)
+{
+	while(ptr < end) {
+		auto run = Scan::findStringSpecial(ptr, end);
+		if(run != ptr) {
+			auto status = bufferChars(ptr, run - ptr);
+			if(status != Status::Ok) {
+				return status;
+			}
+			ptr = run;
+			continue;
+		}
+
+		char c = *ptr++;
+		if(c == '\\') {
+			c = (ptr < end) ? *ptr++ : '\0';
+			switch(c) {
+			case '"':
+			case '\\':
+			case '/':
+				break;
+			case 'b':
+				c = 0x08;
+				break;
+			case 'f':
+				c = '\f';
+				break;
+			case 'n':
+				c = '\n';
+				break;
+			case 'r':
+				c = '\r';
+				break;
+			case 't':
+				c = '\t';
+				break;
+			case 'u': {
+				unsigned codepoint{0};
+				for(unsigned i = 0; i < 4; ++i) {
+					if(ptr == end || !isxdigit(*ptr)) {
+						return Status::HexExpected;
+					}
+					codepoint = (codepoint << 4) | unhex(*ptr++);
+				}
+				// As for BasicStreamingParser, only ASCII is decoded
+				c = (codepoint <= 0x7f) ? char(codepoint) : ' ';
+				break;
+			}
+			default:
+				// Expected escaped character after backslash
+				return Status::BadEscapeChar;
+			}
+		} else if(!isWhiteSpace(c) && (uint8_t(c) < 0x1f || c == 0x7f)) {
+			return Status::UnescapedControl;
+		}
+
+		auto status = bufferChar(c);
+		if(status != Status::Ok) {
+			return status;
+		}
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+void BasicStructuralParser<ListenerT, nestingLimit, Counter>::initElement(Element& elem, Element::Type type)
+{
+	buffer[bufferPos] = '\0';
+	elem.param = param;
+	elem.type = type;
+	elem.level = stack.getLevel();
+	elem.key = buffer;
+	elem.value = &buffer[keyLength + 1];
+	elem.keyLength = keyLength;
+	elem.offset = tokenStart;
+	if(elem.level > 0) {
+		elem.container = stack.peek();
+	}
+	if(bufferPos > keyLength) {
+		elem.valueLength = uint16_t(bufferPos - keyLength - 1);
+	}
+	if(keyView) {
+		elem.key = keyView;
+		elem.keyLength = keyViewLength;
+		elem.keyIsView = true;
+	}
+	if(valueView) {
+		elem.value = valueView;
+		elem.valueLength = valueViewLength;
+		elem.valueIsView = true;
+	}
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::startElement(Element::Type type)
+{
+	if(listener != nullptr) {
+		Element elem;
+		initElement(elem, type);
+		if(elem.level > 0) {
+			stack.increment();
+		}
+		switch(type) {
+		case Element::Type::Number:
+			// Number is terminated by the following character
+			elem.number = number.getNumber(&buffer[keyLength + 1]);
+			elem.endOffset = offset;
+			break;
+		case Element::Type::Object:
+		case Element::Type::Array:
+			break;
+		default:
+			elem.endOffset = offset + 1;
+		}
+		bool ok = segmented ? listener->stringSegment(elem, true) : listener->startElement(elem);
+		if(!ok) {
+			return Status::Cancelled;
+		}
+		skipRequested = listener->checkSkip();
+	}
+
+	peakBufferPos = std::max(peakBufferPos, bufferPos);
+	keyLength = 0;
+	bufferPos = 0;
+	keyView = nullptr;
+	valueView = nullptr;
+	segmented = false;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::endElement(Element::Type type)
+{
+	if(listener != nullptr) {
+		Element elem;
+		elem.param = param;
+		elem.type = type;
+		elem.level = stack.getLevel();
+		elem.endOffset = offset + 1;
+		if(!listener->endElement(elem)) {
+			return Status::Cancelled;
+		}
+	}
+
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::parseKey(size_t start, size_t end)
+{
+	auto ptr = data + start;
+	auto keyEnd = data + end;
+	if(zeroCopy && end - start <= UINT16_MAX && Scan::findStringSpecial(ptr, keyEnd) == keyEnd) {
+		keyView = ptr;
+		keyViewLength = end - start;
+		keyLength = 0;
+	} else {
+		auto status = copyString(ptr, keyEnd);
+		if(status != Status::Ok) {
+			return status;
+		}
+		if(bufferPos > UINT8_MAX) {
+			return Status::BufferFull;
+		}
+		keyLength = bufferPos;
+	}
+
+	buffer[bufferPos++] = '\0';
+	expect = Expect::Colon;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::parseValue(StructuralIndex& index, size_t pos)
+{
+	// Add an empty key if one wasn't provided
+	if(bufferPos == 0) {
+		keyLength = 0;
+		buffer[bufferPos++] = '\0';
+	}
+
+	tokenStart = pos;
+	char c = data[pos];
+	switch(c) {
+	case '[':
+		return startContainer(index, false);
+
+	case '{':
+		return startContainer(index, true);
+
+	case '"': {
+		auto end = index.next();
+		if(end == length) {
+			return Status::NoMoreData;
+		}
+		auto ptr = data + pos + 1;
+		auto valueEnd = data + end;
+		if(zeroCopy && valueEnd - ptr <= UINT16_MAX && Scan::findStringSpecial(ptr, valueEnd) == valueEnd) {
+			valueView = ptr;
+			valueViewLength = valueEnd - ptr;
+		} else {
+			inStringValue = true;
+			auto status = copyString(ptr, valueEnd);
+			inStringValue = false;
+			if(status != Status::Ok) {
+				return status;
+			}
+		}
+		offset = end;
+		expect = Expect::AfterValue;
+		return startElement(Element::Type::String);
+	}
+
+	case 't':
+		return parseLiteral(pos, "true", 4, Element::Type::True, Status::TrueExpected);
+
+	case 'f':
+		return parseLiteral(pos, "false", 5, Element::Type::False, Status::FalseExpected);
+
+	case 'n':
+		return parseLiteral(pos, "null", 4, Element::Type::Null, Status::NullExpected);
+
+	default:
+		if(isdigit(c) || c == '-') {
+			return parseNumber(pos);
+		}
+		// Unexpected character for value
+		return Status::BadValue;
+	}
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::parseNumber(size_t pos)
+{
+	auto ptr = data + pos;
+	auto end = data + length;
+
+	number = {};
+	char c = *ptr++;
+	if(c == '-') {
+		number.value.isNegative = true;
+	} else {
+		number.addDigits(&c, 1);
+	}
+	auto status = bufferChar(c);
+
+	while(status == Status::Ok) {
+		auto run = Scan::findNonDigit(ptr, end);
+		if(run != ptr) {
+			status = bufferChars(ptr, run - ptr);
+			if(status != Status::Ok) {
+				return status;
+			}
+			number.addDigits(ptr, run - ptr);
+			ptr = run;
+		}
+		if(ptr == end) {
+			return Status::NoMoreData;
+		}
+
+		c = *ptr;
+		if(c == '.') {
+			if(number.hasPoint) {
+				// Cannot have multiple decimal points in a number
+				return Status::MultipleDecimalPoints;
+			}
+			if(number.hasExponent) {
+				// Cannot have a decimal point in an exponent
+				return Status::DecimalPointInExponent;
+			}
+			number.hasPoint = true;
+		} else if(c == 'e' || c == 'E') {
+			if(number.hasExponent) {
+				// Cannot have multiple exponents in a number
+				return Status::MultipleExponents;
+			}
+			number.hasExponent = true;
+			c = 'e';
+		} else if(c == '+' || c == '-') {
+			if(buffer[bufferPos - 1] != 'e') {
+				// Can only have '+' or '-' after the 'e' or 'E' in a number
+				return Status::BadExponent;
+			}
+			number.exponentIsNegative = (c == '-');
+		} else {
+			break;
+		}
+		status = bufferChar(c);
+		++ptr;
+	}
+	if(status != Status::Ok) {
+		return status;
+	}
+
+	offset = ptr - data;
+	expect = Expect::AfterValue;
+	status = startElement(Element::Type::Number);
+	if(status == Status::Ok && !isDelimiter(*ptr)) {
+		return afterValueError();
+	}
+	return status;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::parseLiteral(size_t pos, const char* tag,
+																			  uint8_t taglen, Element::Type type,
+																			  Status fail)
+{
+	if(length - pos < taglen) {
+		return Status::NoMoreData;
+	}
+	if(memcmp(&data[pos], tag, taglen) != 0) {
+		return fail;
+	}
+	auto status = bufferChars(tag, taglen);
+	if(status != Status::Ok) {
+		return status;
+	}
+
+	offset = pos + taglen - 1;
+	expect = Expect::AfterValue;
+	status = startElement(type);
+	if(status == Status::Ok && pos + taglen < length && !isDelimiter(data[pos + taglen])) {
+		return afterValueError();
+	}
+	return status;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::startContainer(StructuralIndex& index, bool isObject)
+{
+	auto status = startElement(isObject ? Element::Type::Object : Element::Type::Array);
+	if(status != Status::Ok) {
+		return status;
+	}
+	if(skipRequested) {
+		return skipContainer(index);
+	}
+	if(!stack.push(isObject)) {
+		return Status::StackFull;
+	}
+	expect = isObject ? Expect::ObjectKey : Expect::ArrayValue;
+	return Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::endContainer(bool isObject)
+{
+	stack.pop();
+	auto status = endElement(isObject ? Element::Type::Object : Element::Type::Array);
+	if(status != Status::Ok) {
+		return status;
+	}
+	expect = Expect::AfterValue;
+	return stack.isEmpty() ? Status::EndOfDocument : Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::skipContainer(StructuralIndex& index)
+{
+	// String content contains no structural positions, so only brackets need counting
+	for(unsigned depth = 1; depth != 0;) {
+		auto pos = index.next();
+		if(pos == length) {
+			return Status::NoMoreData;
+		}
+		switch(data[pos]) {
+		case '"':
+			// Closing quote
+			if(index.next() == length) {
+				return Status::NoMoreData;
+			}
+			break;
+		case '[':
+		case '{':
+			++depth;
+			break;
+		case ']':
+		case '}':
+			--depth;
+			break;
+		default:;
+		}
+	}
+
+	expect = Expect::AfterValue;
+	return stack.isEmpty() ? Status::EndOfDocument : Status::Ok;
+}
+
+template <class ListenerT, unsigned nestingLimit, typename Counter>
+Status BasicStructuralParser<ListenerT, nestingLimit, Counter>::parse(const char* data, size_t length)
+{
+	this->data = data;
+	this->length = length;
+	stack.clear();
+	keyLength = 0;
+	bufferPos = 0;
+	peakBufferPos = 0;
+	keyView = nullptr;
+	valueView = nullptr;
+	segmented = false;
+	inStringValue = false;
+
+	StructuralIndex index(data, length);
+	auto pos = index.next();
+	if(pos == length) {
+		return Status::NoMoreData;
+	}
+	offset = tokenStart = pos;
+	Status status;
+	switch(data[pos]) {
+	case '[':
+		status = startContainer(index, false);
+		break;
+	case '{':
+		status = startContainer(index, true);
+		break;
+	default:
+		// Document must start with object or array
+		return Status::OpeningBraceExpected;
+	}
+
+	while(status == Status::Ok) {
+		pos = index.next();
+		if(pos == length) {
+			return Status::NoMoreData;
+		}
+		offset = pos;
+		char c = data[pos];
+		switch(expect) {
+		case Expect::ObjectKey: {
+			if(c == '}') {
+				status = endContainer(true);
+				break;
+			}
+			if(c != '"') {
+				// Start of string expected for object key
+				return Status::StringStartExpected;
+			}
+			auto end = index.next();
+			if(end == length) {
+				return Status::NoMoreData;
+			}
+			status = parseKey(pos + 1, end);
+			break;
+		}
+
+		case Expect::Colon:
+			if(c != ':') {
+				// Expected ':' after key
+				return Status::ColonExpected;
+			}
+			expect = Expect::Value;
+			break;
+
+		case Expect::ArrayValue:
+			if(c == ']') {
+				status = endContainer(false);
+				break;
+			}
+			status = parseValue(index, pos);
+			break;
+
+		case Expect::Value:
+			status = parseValue(index, pos);
+			break;
+
+		case Expect::AfterValue:
+			if(stack.peek().isObject) {
+				if(c == '}') {
+					status = endContainer(true);
+				} else if(c == ',') {
+					expect = Expect::ObjectKey;
+				} else {
+					// Expected ',' or '}'
+					return Status::CommaOrClosingBraceExpected;
+				}
+			} else if(c == ']') {
+				status = endContainer(false);
+			} else if(c == ',') {
+				expect = Expect::ArrayValue;
+			} else {
+				// Expected ',' or ']' while parsing array
+				return Status::CommaOrClosingBracketExpected;
+			}
+			break;
+		}
+	}
+
+	return status;
+}
+
+} // namespace JSON